@@ -111,6 +111,7 @@ void run_on_every_x_hooks( lua_state & ) {}
 #include "mod_manager.h"
 #include "path_info.h"
 #include "point.h"
+#include "turn_profiler.h"
 #include "worldfactory.h"
 
 namespace cata
@@ -389,6 +390,7 @@ void reg_lua_iuse_actors( lua_state &state, Item_factory &ifactory )
 
 void run_on_every_x_hooks( lua_state &state )
 {
+    CATA_TURN_ZONE( "lua_hooks" );
     std::vector<cata::on_every_x_hooks> &master_table =
         state.lua["game"]["cata_internal"]["on_every_x_hooks"];
     for( const auto &entry : master_table ) {
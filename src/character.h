@@ -2107,6 +2107,9 @@ class Character : public Creature, public location_visitable<Character>
         const inventory &crafting_inventory( bool clear_path );
         const inventory &crafting_inventory( const tripoint &src_pos = tripoint_zero,
                                              int radius = PICKUP_RANGE, bool clear_path = true );
+        /** The part of the crafting inventory that's on the map around @p src_pos */
+        const inventory &crafting_map_inventory( const tripoint &src_pos = tripoint_zero,
+                int radius = PICKUP_RANGE, bool clear_path = true );
         void invalidate_crafting_inventory();
 
         /** Returns all known recipes. */
@@ -2331,7 +2334,19 @@ class Character : public Creature, public location_visitable<Character>
 
         int cached_moves = 0;
         tripoint cached_position;
+        int cached_crafting_revision = 0;
         inventory cached_crafting_inventory;
+        /**
+         * The part of cached_crafting_inventory that's on the map.  It's kept while the map's
+         * contents stay the same, but only within a turn, as the temporary items made for it
+         * don't last longer than that.
+         */
+        inventory cached_map_inventory;
+        tripoint cached_map_position = tripoint_min;
+        int cached_map_radius = 0;
+        bool cached_map_clear_path = false;
+        int cached_map_revision = 0;
+        time_point cached_map_time = calendar::before_time_starts;
 
         mutable std::array<double, npc_ai_info::num_npc_ai_info> npc_ai_info_cache;
 
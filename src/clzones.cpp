@@ -577,6 +577,15 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
     return type_iter != area_cache.end();
 }
 
+void zone_manager::zone_cache::add( const zone_data &zone )
+{
+    areas.emplace_back( zone.get_start_point(), zone.get_end_point() );
+    for( const tripoint &p : tripoint_range<tripoint>( zone.get_start_point(),
+            zone.get_end_point() ) ) {
+        points.insert( p );
+    }
+}
+
 void zone_manager::cache_data()
 {
     area_cache.clear();
@@ -585,15 +594,7 @@ void zone_manager::cache_data()
         if( !elem.get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem.get_start_point(),
-                elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        area_cache[elem.get_type_hash()].add( elem );
     }
 }
 
@@ -605,29 +606,62 @@ void zone_manager::cache_vzones()
         if( !elem->get_enabled() ) {
             continue;
         }
+        vzone_cache[elem->get_type_hash()].add( *elem );
+    }
+}
+
+const zone_manager::zone_cache *zone_manager::get_area_cache( const zone_type_id &type,
+        const faction_id &fac ) const
+{
+    const auto type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
+    return type_iter == area_cache.end() ? nullptr : &type_iter->second;
+}
 
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
+const zone_manager::zone_cache *zone_manager::get_vzone_cache( const zone_type_id &type,
+        const faction_id &fac ) const
+{
+    //Only regenerate the vehicle zone cache if any vehicles have moved
+    const auto type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
+    return type_iter == vzone_cache.end() ? nullptr : &type_iter->second;
+}
 
-        // TODO: looks very similar to the above cache_data - maybe merge it?
+static const std::unordered_set<tripoint> no_points;
 
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem->get_start_point(),
-                elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
-    }
+const std::unordered_set<tripoint> &zone_manager::get_point_set( const zone_type_id &type,
+        const faction_id &fac ) const
+{
+    const zone_cache *cache = get_area_cache( type, fac );
+    return cache ? cache->points : no_points;
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
+const std::unordered_set<tripoint> &zone_manager::get_vzone_set( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
-    }
+    const zone_cache *cache = get_vzone_cache( type, fac );
+    return cache ? cache->points : no_points;
+}
+
+// Square of the given range around where, on its z-level only
+static inclusive_cuboid<tripoint> square_around( const tripoint &where, int range )
+{
+    return inclusive_cuboid<tripoint>( where - tripoint( range, range, 0 ),
+                                       where + tripoint( range, range, 0 ) );
+}
 
-    return type_iter->second;
+// The part of area inside bounds, or nothing if they don't overlap
+static std::optional<inclusive_cuboid<tripoint>> overlap( const inclusive_cuboid<tripoint> &area,
+        const inclusive_cuboid<tripoint> &bounds )
+{
+    const inclusive_cuboid<tripoint> result(
+        tripoint( std::max( area.p_min.x, bounds.p_min.x ), std::max( area.p_min.y, bounds.p_min.y ),
+                  std::max( area.p_min.z, bounds.p_min.z ) ),
+        tripoint( std::min( area.p_max.x, bounds.p_max.x ), std::min( area.p_max.y, bounds.p_max.y ),
+                  std::min( area.p_max.z, bounds.p_max.z ) ) );
+    if( result.p_min.x > result.p_max.x || result.p_min.y > result.p_max.y ||
+        result.p_min.z > result.p_max.z ) {
+        return std::nullopt;
+    }
+    return result;
 }
 
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
@@ -639,12 +673,29 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
         int radius, bool npc_search, const faction_id &/*fac*/ ) const
 {
+    // Same as get_zone_at, but only for the zones that can be in range
+    std::vector<const zone_data *> zones_in_range;
+    const inclusive_cuboid<tripoint> bounds = square_around( where, radius );
+    for( auto it = zones.rbegin(); it != zones.rend(); ++it ) {
+        if( overlap( inclusive_cuboid<tripoint>( it->get_start_point(), it->get_end_point() ),
+                     bounds ) ) {
+            zones_in_range.push_back( &*it );
+        }
+    }
+    if( zones_in_range.empty() ) {
+        return {};
+    }
+
     std::unordered_set<tripoint> res;
     map &here = get_map();
     for( const tripoint elem : here.points_in_radius( here.getlocal( where ), radius ) ) {
-        const zone_data *zone = get_zone_at( here.getabs( elem ) );
+        const tripoint abs = here.getabs( elem );
+        const auto zone = std::find_if( zones_in_range.begin(), zones_in_range.end(),
+        [&abs]( const zone_data * z ) {
+            return z->has_inside( abs );
+        } );
         // if not a LOOT zone
-        if( ( !zone ) || ( zone->get_type().str().substr( 0, 4 ) != "LOOT" ) ) {
+        if( zone == zones_in_range.end() || ( *zone )->get_type().str().substr( 0, 4 ) != "LOOT" ) {
             continue;
         }
         if( npc_search && ( has( zone_NO_NPC_PICKUP, elem ) ) ) {
@@ -655,18 +706,6 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
-    }
-
-    return type_iter->second;
-}
-
 bool zone_manager::has( const zone_type_id &type, const tripoint &where,
                         const faction_id &fac ) const
 {
@@ -678,24 +717,19 @@ bool zone_manager::has( const zone_type_id &type, const tripoint &where,
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    const inclusive_cuboid<tripoint> bounds = square_around( where, range );
+    for( const zone_cache *cache : {
+             get_area_cache( type, fac ), get_vzone_cache( type, fac )
+         } ) {
+        if( !cache ) {
+            continue;
         }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
+        for( const inclusive_cuboid<tripoint> &area : cache->areas ) {
+            if( overlap( area, bounds ) ) {
                 return true;
             }
         }
     }
-
     return false;
 }
 
@@ -732,49 +766,76 @@ const zone_data *zone_manager::get_zone_at( const tripoint &where, const zone_ty
     return nullptr;
 }
 
+static bool custom_loot_matches( const zone_data &zone, const item &it )
+{
+    const loot_options &options = dynamic_cast<const loot_options &>( zone.get_options() );
+    return item_filter_from_string( options.get_mark() )( it );
+}
+
 bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) const
 {
     auto zone = get_zone_at( where, zone_LOOT_CUSTOM );
     if( !zone || !it ) {
         return false;
     }
-    const loot_options &options = dynamic_cast<const loot_options &>( zone->get_options() );
-    std::string filter_string = options.get_mark();
-    auto z = item_filter_from_string( filter_string );
-
-    return z( *it );
+    return custom_loot_matches( *zone, *it );
 }
 
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    auto near_point_set = std::unordered_set<tripoint>();
-
-    for( auto &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
+    const inclusive_cuboid<tripoint> bounds = square_around( where, range );
+
+    // The custom loot zones that custom_loot_has could pick in range, in the same order, with
+    // whether the item matches their filter once that's needed
+    std::vector<std::pair<const zone_data *, std::optional<bool>>> custom_zones;
+    const bool check_custom = it && ( get_area_cache( zone_LOOT_CUSTOM ) ||
+                                      get_vzone_cache( zone_LOOT_CUSTOM ) );
+    if( check_custom ) {
+        const auto add_custom = [&]( const zone_data & zone ) {
+            if( zone.get_type() == zone_LOOT_CUSTOM &&
+                overlap( inclusive_cuboid<tripoint>( zone.get_start_point(), zone.get_end_point() ),
+                         bounds ) ) {
+                custom_zones.emplace_back( &zone, std::nullopt );
             }
+        };
+        for( const zone_data &zone : zones ) {
+            add_custom( zone );
+        }
+        for( const zone_data *zone : get_map().get_vehicle_zones( g->get_levz() ) ) {
+            add_custom( *zone );
         }
     }
+    const auto custom_loot_allows = [&]( const tripoint & p ) {
+        if( !has( zone_LOOT_CUSTOM, p ) ) {
+            return true;
+        }
+        for( auto &custom : custom_zones ) {
+            if( custom.first->has_inside( p ) ) {
+                if( !custom.second ) {
+                    custom.second = custom_loot_matches( *custom.first, *it );
+                }
+                return *custom.second;
+            }
+        }
+        return false;
+    };
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
+    auto near_point_set = std::unordered_set<tripoint>();
+    for( const zone_cache *cache : {
+             get_area_cache( type, fac ), get_vzone_cache( type, fac )
+         } ) {
+        if( !cache ) {
+            continue;
+        }
+        for( const inclusive_cuboid<tripoint> &area : cache->areas ) {
+            const std::optional<inclusive_cuboid<tripoint>> near = overlap( area, bounds );
+            if( !near ) {
+                continue;
+            }
+            for( const tripoint &p : tripoint_range<tripoint>( near->p_min, near->p_max ) ) {
+                if( !check_custom || custom_loot_allows( p ) ) {
+                    near_point_set.insert( p );
                 }
             }
         }
@@ -792,26 +853,22 @@ std::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, con
 
     tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
+    for( const zone_cache *cache : {
+             get_area_cache( type, fac ), get_vzone_cache( type, fac )
+         } ) {
+        if( !cache ) {
+            continue;
         }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+        for( const inclusive_cuboid<tripoint> &area : cache->areas ) {
+            // The closest point of the zone
+            const tripoint p = clamp( where, area );
+            const int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
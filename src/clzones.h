@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "cuboid_rectangle.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "string_id.h"
@@ -354,11 +355,24 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
+        // Enabled zones of one type and faction
+        struct zone_cache {
+            std::unordered_set<tripoint> points;
+            // The zones themselves, so that what's near a point can be found without
+            // going through all of their points
+            std::vector<inclusive_cuboid<tripoint>> areas;
+
+            void add( const zone_data &zone );
+        };
+        std::unordered_map<std::string, zone_cache> area_cache;
+        std::unordered_map<std::string, zone_cache> vzone_cache;
+        const zone_cache *get_area_cache( const zone_type_id &type,
+                                          const faction_id &fac = your_fac ) const;
+        const zone_cache *get_vzone_cache( const zone_type_id &type,
+                                           const faction_id &fac = your_fac ) const;
+        const std::unordered_set<tripoint> &get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
+        const std::unordered_set<tripoint> &get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
 
         //Cache number of items already checked on each source tile when sorting
@@ -553,10 +553,11 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     }
     if( cached_moves == moves
         && cached_time == calendar::turn
-        && cached_position == inv_pos ) {
+        && cached_position == inv_pos
+        && cached_crafting_revision == get_map().get_contents_revision() ) {
         return cached_crafting_inventory;
     }
-    cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
+    cached_crafting_inventory = crafting_map_inventory( inv_pos, radius, clear_path );
     cached_crafting_inventory += inv;
     cached_crafting_inventory += primary_weapon();
     cached_crafting_inventory += worn;
@@ -576,15 +577,39 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     cached_moves = moves;
     cached_time = calendar::turn;
     cached_position = inv_pos;
+    cached_crafting_revision = get_map().get_contents_revision();
     // cache the qualities of the items in cached_crafting_inventory
     cached_crafting_inventory.update_quality_cache();
     return cached_crafting_inventory;
 }
 
+const inventory &Character::crafting_map_inventory( const tripoint &src_pos, int radius,
+        bool clear_path )
+{
+    map &here = get_map();
+    const tripoint inv_pos = src_pos == tripoint_zero ? pos() : src_pos;
+    const tripoint abs_pos = here.getabs( inv_pos );
+    if( cached_map_time == calendar::turn
+        && cached_map_position == abs_pos
+        && cached_map_radius == radius
+        && cached_map_clear_path == clear_path
+        && cached_map_revision == here.get_contents_revision() ) {
+        return cached_map_inventory;
+    }
+    cached_map_inventory.form_from_map( here, inv_pos, radius, this, false, clear_path );
+    cached_map_time = calendar::turn;
+    cached_map_position = abs_pos;
+    cached_map_radius = radius;
+    cached_map_clear_path = clear_path;
+    cached_map_revision = here.get_contents_revision();
+    return cached_map_inventory;
+}
+
 void Character::invalidate_crafting_inventory()
 {
     cached_time = calendar::before_time_starts;
     cached_position = tripoint_min;
+    cached_map_time = calendar::before_time_starts;
 }
 
 void player::make_craft( const recipe_id &id_to_make, int batch_size, const tripoint &loc )
@@ -1223,8 +1248,7 @@ bool player::can_continue_craft( item &craft )
             }
         }
 
-        inventory map_inv;
-        map_inv.form_from_map( pos(), PICKUP_RANGE, this );
+        const inventory &map_inv = crafting_map_inventory();
 
         std::vector<comp_selection<item_comp>> item_selections;
         for( const auto &it : continue_reqs.get_components() ) {
@@ -1277,8 +1301,7 @@ bool player::can_continue_craft( item &craft )
             return false;
         }
 
-        inventory map_inv;
-        map_inv.form_from_map( pos(), PICKUP_RANGE, this );
+        const inventory &map_inv = crafting_map_inventory();
 
         std::vector<comp_selection<tool_comp>> new_tool_selections;
         for( const std::vector<tool_comp> &alternatives : tool_reqs ) {
@@ -1331,7 +1354,7 @@ const requirement_data *player::select_requirements(
 
 /* selection of component if a recipe requirement has multiple options (e.g. 'duct tap' or 'welder') */
 comp_selection<item_comp> player::select_item_component( const std::vector<item_comp> &components,
-        int batch, inventory &map_inv, bool can_cancel,
+        int batch, const inventory &map_inv, bool can_cancel,
         const std::function<bool( const item & )> &filter, bool player_inv )
 {
     std::vector<item_comp> player_has;
@@ -1614,8 +1637,7 @@ std::vector<detached_ptr<item>> player::consume_items( const std::vector<item_co
                              int batch,
                              const std::function<bool( const item & )> &filter )
 {
-    inventory map_inv;
-    map_inv.form_from_map( pos(), PICKUP_RANGE, this );
+    const inventory &map_inv = crafting_map_inventory();
     return consume_items( select_item_component( components, batch, map_inv, false, filter ), batch,
                           filter );
 }
@@ -1829,8 +1851,7 @@ bool player::craft_consume_tools( item &craft, int mulitplier, bool start_craft
     const std::vector<comp_selection<tool_comp>> &cached_tool_selections =
                 craft.get_cached_tool_selections();
 
-    inventory map_inv;
-    map_inv.form_from_map( pos(), PICKUP_RANGE, this );
+    const inventory &map_inv = crafting_map_inventory();
 
     for( const comp_selection<tool_comp> &tool_sel : cached_tool_selections ) {
         itype_id type = tool_sel.comp.type;
@@ -1912,8 +1933,7 @@ to consume_tools */
 void player::consume_tools( const std::vector<tool_comp> &tools, int batch,
                             const std::string &hotkeys )
 {
-    inventory map_inv;
-    map_inv.form_from_map( pos(), PICKUP_RANGE, this );
+    const inventory &map_inv = crafting_map_inventory();
     consume_tools( crafting::select_tool_component( tools, batch, map_inv, this, false, hotkeys,
                    cost_adjustment::none ), batch );
 }
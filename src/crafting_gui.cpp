@@ -136,20 +136,65 @@ void reset_recipe_categories()
 
 namespace
 {
+/**
+ * Whether the crafting inventory has anything at all for each requirement group of a recipe,
+ * see @ref requirement_data::could_make_with_inventory.
+ */
+struct recipe_presence {
+    bool deduped = true;
+    bool simple = true;
+};
+
+/**
+ * Adds the presence of all @p recipes not in @p cache yet, finding it for all of them in one
+ * pass over the inventory instead of one recipe at a time.
+ */
+void cache_recipe_presence( std::unordered_map<const recipe *, recipe_presence> &cache,
+                            const recipe_subset &recipes, const inventory &inv )
+{
+    std::vector<const recipe *> added;
+    std::vector<const requirement_data *> reqs;
+    for( const recipe *r : recipes ) {
+        if( cache.contains( r ) ) {
+            continue;
+        }
+        added.push_back( r );
+        reqs.push_back( &r->simple_requirements() );
+        for( const requirement_data &alt : r->deduped_requirements().alternatives() ) {
+            reqs.push_back( &alt );
+        }
+    }
+    const std::vector<bool> could_make = requirement_data::could_make_with_inventory(
+            reqs, inv, 1, cost_adjustment::start_only );
+    auto could = could_make.begin();
+    for( const recipe *r : added ) {
+        recipe_presence &presence = cache[r];
+        presence.simple = *could++;
+        const size_t alternatives = r->deduped_requirements().alternatives().size();
+        presence.deduped = std::any_of( could, could + alternatives, []( bool b ) {
+            return b;
+        } );
+        could += alternatives;
+    }
+}
+
 struct availability {
-    explicit availability( const recipe *r, int batch_size, bool known ) {
+    explicit availability( const recipe *r, int batch_size, bool known,
+                           const recipe_presence &presence = recipe_presence() ) {
         this->known = known;
         const inventory &inv = get_avatar().crafting_inventory();
         auto all_items_filter = r->get_component_filter( recipe_filter_flags::none );
         auto no_rotten_filter = r->get_component_filter( recipe_filter_flags::no_rotten );
+        // Recipes the inventory has nothing for aren't checked in full
         const deduped_requirement_data &req = r->deduped_requirements();
-        could_craft_if_knew = req.can_make_with_inventory(
+        could_craft_if_knew = presence.deduped && req.can_make_with_inventory(
                                   inv, all_items_filter, batch_size, cost_adjustment::start_only );
         can_craft = known && could_craft_if_knew;
-        can_craft_non_rotten = req.can_make_with_inventory(
+        can_craft_non_rotten = presence.deduped && req.can_make_with_inventory(
                                    inv, no_rotten_filter, batch_size, cost_adjustment::start_only );
         const requirement_data &simple_req = r->simple_requirements();
-        apparently_craftable = simple_req.can_make_with_inventory(
+        simple_checked = presence.simple;
+        apparently_craftable = presence.simple && simple_req.can_make_with_inventory(
                                    inv, all_items_filter, batch_size, cost_adjustment::start_only );
         has_all_skills = r->skill_used.is_null() ||
                          get_player_character().get_skill_level( r->skill_used ) >= r->difficulty;
@@ -166,6 +211,8 @@ struct availability {
     bool apparently_craftable;
     bool has_all_skills;
     bool known;
+    // Whether the simple requirements were checked in full, updating how they are shown
+    bool simple_checked;
 
     nc_color selected_color() const {
         return can_craft
@@ -269,6 +316,10 @@ static std::vector<std::string> recipe_info(
     std::vector<std::string> result = foldstring( oss.str(), fold_width );
 
     const requirement_data &req = recp.simple_requirements();
+    if( !avail.simple_checked ) {
+        req.can_make_with_inventory( crafting_inv, recp.get_component_filter(), batch_size,
+                                     cost_adjustment::start_only );
+    }
     const std::vector<std::string> tools = req.get_folded_tools_list(
             fold_width, color, crafting_inv, batch_size );
     const std::vector<std::string> comps = req.get_folded_components_list(
@@ -484,6 +535,7 @@ const recipe *select_crafting_recipe( int &batch_size_out )
 
     const auto &available_recipes = u.get_available_recipes( crafting_inv, &helpers );
     std::unordered_map<const recipe *, availability> availability_cache( available_recipes.size() );
+    std::unordered_map<const recipe *, recipe_presence> presence_cache( available_recipes.size() );
 
     std::vector<const recipe *> all_recipes_flat;
     for( const auto &pr : recipe_dict ) {
@@ -715,11 +767,20 @@ const recipe *select_crafting_recipe( int &batch_size_out )
                 }
 
                 available.reserve( current.size() );
+                // rule out what can't be made for every shown recipe at once
+                const bool presence_cached = std::all_of( current.begin(), current.end(),
+                [&]( const recipe * e ) {
+                    return presence_cache.contains( e );
+                } );
+                if( !presence_cached ) {
+                    cache_recipe_presence( presence_cache, shown_recipes, crafting_inv );
+                }
                 // cache recipe availability on first display
                 for( const recipe *e : current ) {
                     if( !availability_cache.contains( e ) ) {
                         availability_cache.emplace( e, availability( e, 1,
-                                                    !show_unavailable || available_recipes.contains( *e ) ) );
+                                                    !show_unavailable || available_recipes.contains( *e ),
+                                                    presence_cache[e] ) );
                     }
                 }
 
@@ -291,6 +291,15 @@ bool Creature::sees( const Creature &critter ) const
     map &here = get_map();
     const Character *ch = critter.as_character();
     const int wanted_range = rl_dist( pos(), critter.pos() );
+    // Every monster looks for the same few NPCs each turn, so they share a field of view
+    // cast from each NPC instead of tracing a line each
+    const auto sees_critter = [&]( int range_mod ) {
+        if( !is_monster() || !critter.is_npc() || ( !fov_3d && posz() != critter.posz() ) ) {
+            return sees( critter.pos(), critter.is_avatar(), range_mod );
+        }
+        const int range = sight_range_to( critter.pos(), range_mod );
+        return range >= 0 && here.sees_shared( pos(), critter.pos(), range );
+    };
     // Can always see adjacent monsters on the same level, unless they're through a vehicle wall.
     // We also bypass lighting for vertically adjacent monsters, but still check for floors.
     if( wanted_range <= 1 && ( posz() == critter.posz() || here.sees( pos(), critter.pos(), 1 ) ) ) {
@@ -310,7 +319,7 @@ bool Creature::sees( const Creature &critter ) const
         if( ch->movement_mode_is( CMM_CROUCH ) ) {
             const int coverage = here.obstacle_coverage( pos(), critter.pos() );
             if( coverage < 30 ) {
-                return sees( critter.pos(), critter.is_avatar() ) && visible( ch );
+                return sees_critter( 0 ) && visible( ch );
             }
             float size_modifier = 1.0;
             switch( ch->get_size() ) {
@@ -333,20 +342,16 @@ bool Creature::sees( const Creature &critter ) const
             }
             const int vision_modifier = 30 - 0.5 * coverage * size_modifier;
             if( vision_modifier > 1 ) {
-                return sees( critter.pos(), critter.is_avatar(), vision_modifier ) && visible( ch );
+                return sees_critter( vision_modifier ) && visible( ch );
             }
             return false;
         }
     }
-    return sees( critter.pos(), critter.is_avatar() ) && visible( ch );
+    return sees_critter( 0 ) && visible( ch );
 }
 
-bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
+int Creature::sight_range_to( const tripoint &t, int range_mod ) const
 {
-    if( !fov_3d && posz() != t.z ) {
-        return false;
-    }
-
     map &here = get_map();
     const int range_cur = sight_range( here.ambient_light_at( t ) );
     const int range_day = sight_range( default_daylight_level() );
@@ -369,18 +374,32 @@ bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
         if( range_mod > 0 ) {
             range = std::min( range, range_mod );
         }
-        if( is_avatar ) {
-            // Special case monster -> player visibility, forcing it to be symmetric with player vision.
-            const float player_visibility_factor = g->u.visibility() / 100.0f;
-            int adj_range = std::floor( range * player_visibility_factor );
-            return adj_range >= wanted_range &&
-                   here.get_cache_ref( pos().z ).seen_cache[pos().x][pos().y] > LIGHT_TRANSPARENCY_SOLID;
-        } else {
-            return here.sees( pos(), t, range );
-        }
+        return range;
     } else {
+        return -1;
+    }
+}
+
+bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
+{
+    if( !fov_3d && posz() != t.z ) {
+        return false;
+    }
+
+    const int range = sight_range_to( t, range_mod );
+    if( range < 0 ) {
         return false;
     }
+    map &here = get_map();
+    if( is_avatar ) {
+        // Special case monster -> player visibility, forcing it to be symmetric with player vision.
+        const float player_visibility_factor = g->u.visibility() / 100.0f;
+        int adj_range = std::floor( range * player_visibility_factor );
+        return adj_range >= rl_dist( pos(), t ) &&
+               here.get_cache_ref( pos().z ).seen_cache[pos().x][pos().y] > LIGHT_TRANSPARENCY_SOLID;
+    } else {
+        return here.sees( pos(), t, range );
+    }
 }
 
 // Helper function to check if potential area of effect of a weapon overlaps vehicle
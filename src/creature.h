@@ -301,6 +301,13 @@ class Creature
         virtual bool sees( const Creature &critter ) const;
         virtual bool sees( const tripoint &t, bool is_avatar = false, int range_mod = 0 ) const;
         /*@}*/
+    private:
+        /**
+         * Range at which this creature can see `t` given the light there, limited by `range_mod`
+         * if that's positive.  -1 if it can't see that far.
+         */
+        int sight_range_to( const tripoint &t, int range_mod ) const;
+    public:
 
         /**
          * How far the creature sees under the given light. Places outside this range can
@@ -2,11 +2,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <ostream>
 #include <string>
 #include <utility>
 
 #include "debug.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -86,7 +88,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +166,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -180,11 +185,142 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     }
 }
 
+// Index into Creature_tracker::monster_buckets, -1 if outside of the reality bubble
+static int bucket_index( const tripoint &pos )
+{
+    if( pos.x < 0 || pos.y < 0 || pos.x >= MAPSIZE_X || pos.y >= MAPSIZE_Y ||
+        pos.z < -OVERMAP_DEPTH || pos.z > OVERMAP_HEIGHT ) {
+        return -1;
+    }
+    return ( ( pos.z + OVERMAP_DEPTH ) * MAPSIZE + pos.y / SEEY ) * MAPSIZE + pos.x / SEEX;
+}
+
+std::vector<monster *> &Creature_tracker::bucket_at( const tripoint &pos )
+{
+    const int index = bucket_index( pos );
+    return index < 0 ? monsters_outside_buckets : monster_buckets[index];
+}
+
+void Creature_tracker::set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() ) {
+        if( iter->second == critter ) {
+            return;
+        }
+        erase_location( iter );
+    }
+    monsters_by_location.emplace( pos, critter );
+    bucket_at( pos ).push_back( critter.get() );
+    if( bucket_index( pos ) >= 0 ) {
+        monsters_on_zlevel[pos.z + OVERMAP_DEPTH]++;
+    }
+}
+
+void Creature_tracker::erase_location( std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator
+                                       iter )
+{
+    const tripoint &pos = iter->first;
+    std::vector<monster *> &bucket = bucket_at( pos );
+    const auto in_bucket = std::find( bucket.begin(), bucket.end(), iter->second.get() );
+    if( in_bucket != bucket.end() ) {
+        *in_bucket = bucket.back();
+        bucket.pop_back();
+    }
+    if( bucket_index( pos ) >= 0 ) {
+        monsters_on_zlevel[pos.z + OVERMAP_DEPTH]--;
+    }
+    monsters_by_location.erase( iter );
+}
+
+void Creature_tracker::clear_locations()
+{
+    monsters_by_location.clear();
+    for( std::vector<monster *> &bucket : monster_buckets ) {
+        bucket.clear();
+    }
+    monsters_outside_buckets.clear();
+    monsters_on_zlevel.fill( 0 );
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, int radius,
+        int radiusz ) const
+{
+    std::vector<monster *> result;
+    const auto consider = [&]( monster * critter ) {
+        const tripoint &pos = critter->pos();
+        if( std::abs( pos.x - center.x ) <= radius && std::abs( pos.y - center.y ) <= radius &&
+            std::abs( pos.z - center.z ) <= radiusz && !critter->is_dead() ) {
+            result.push_back( critter );
+        }
+    };
+
+    const int min_x = std::max( center.x - radius, 0 );
+    const int max_x = std::min( center.x + radius, MAPSIZE_X - 1 );
+    const int min_y = std::max( center.y - radius, 0 );
+    const int max_y = std::min( center.y + radius, MAPSIZE_Y - 1 );
+    const int min_z = std::max( center.z - radiusz, -OVERMAP_DEPTH );
+    const int max_z = std::min( center.z + radiusz, OVERMAP_HEIGHT );
+    if( min_x <= max_x && min_y <= max_y ) {
+        for( int z = min_z; z <= max_z; z++ ) {
+            if( monsters_on_zlevel[z + OVERMAP_DEPTH] == 0 ) {
+                continue;
+            }
+            for( int y = min_y / SEEY; y <= max_y / SEEY; y++ ) {
+                for( int x = min_x / SEEX; x <= max_x / SEEX; x++ ) {
+                    for( monster *critter : monster_buckets[bucket_index( { x * SEEX, y * SEEY, z } )] ) {
+                        consider( critter );
+                    }
+                }
+            }
+        }
+    }
+    for( monster *critter : monsters_outside_buckets ) {
+        consider( critter );
+    }
+    return result;
+}
+
+std::vector<monster *> Creature_tracker::find_nearest( const tripoint &center, size_t count,
+        int max_radius ) const
+{
+    std::vector<std::pair<int, monster *>> found;
+    if( count == 0 || max_radius < 0 ) {
+        return {};
+    }
+    // Everything within the square searched so far is known, grow it until it has enough
+    for( int radius = std::min( SEEX, max_radius ); ; radius = std::min( radius * 2, max_radius ) ) {
+        found.clear();
+        for( monster *critter : find_in_radius( center, radius ) ) {
+            const int dist = rl_dist( center, critter->pos() );
+            if( dist <= radius ) {
+                found.emplace_back( dist, critter );
+            }
+        }
+        if( found.size() >= count || radius >= max_radius ) {
+            break;
+        }
+    }
+
+    std::sort( found.begin(), found.end(), []( const std::pair<int, monster *> &lhs,
+    const std::pair<int, monster *> &rhs ) {
+        if( lhs.first != rhs.first ) {
+            return lhs.first < rhs.first;
+        }
+        return lhs.second->pos() < rhs.second->pos();
+    } );
+    std::vector<monster *> result;
+    for( size_t i = 0; i < found.size() && i < count; i++ ) {
+        result.push_back( found[i].second );
+    }
+    return result;
+}
+
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -195,7 +331,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
     }
 }
 
@@ -227,17 +363,17 @@ void Creature_tracker::remove( const monster &critter )
 void Creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +392,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +408,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
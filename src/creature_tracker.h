@@ -2,12 +2,14 @@
 #ifndef CATA_SRC_CREATURE_TRACKER_H
 #define CATA_SRC_CREATURE_TRACKER_H
 
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
+#include "game_constants.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "type_id.h"
@@ -86,6 +88,20 @@ class Creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Living monsters at most @p radius tiles away from @p center horizontally
+         * (in square distance, so every monster within that @ref rl_dist is included)
+         * and at most @p radiusz z-levels away. In no particular order.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius,
+                                               int radiusz = 0 ) const;
+        /**
+         * Up to @p count living monsters on the z-level of @p center, nearest (by @ref rl_dist) first.
+         * Monsters further than @p max_radius are ignored.
+         */
+        std::vector<monster *> find_nearest( const tripoint &center, size_t count,
+                                             int max_radius ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
@@ -96,6 +112,21 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * Same contents as @ref monsters_by_location, bucketed by the submap of the reality bubble
+         * they are on. Monsters outside of the bubble (possible while the map shifts) are kept
+         * in @ref monsters_outside_buckets.
+         */
+        static constexpr int bucket_count = MAPSIZE * MAPSIZE * OVERMAP_LAYERS;
+        std::array<std::vector<monster *>, bucket_count> monster_buckets;
+        std::vector<monster *> monsters_outside_buckets;
+        std::array<int, OVERMAP_LAYERS> monsters_on_zlevel = {};
+
+        std::vector<monster *> &bucket_at( const tripoint &pos );
+        /** Place the monster in @ref monsters_by_location and the buckets, replacing whatever was there. */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        void erase_location( std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator iter );
+        void clear_locations();
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
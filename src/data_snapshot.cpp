@@ -0,0 +1,230 @@
+#include "data_snapshot.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "debug.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "get_version.h"
+#include "init.h"
+#include "mod_manager.h"
+#include "path_info.h"
+#include "string_formatter.h"
+#include "submap_binary.h"
+
+bool rebuild_data_snapshot = false;
+bool use_data_snapshot_in_tests = false;
+
+static constexpr std::string_view snapshot_magic = "CBND";
+static constexpr std::uint32_t snapshot_version = 2;
+// Snapshots of other lists of content packs are kept for this many, e.g. for other worlds
+static constexpr size_t max_snapshots = 4;
+
+// FNV-1a, only used to tell apart lists of content packs
+static void hash_string( std::uint64_t &hash, const std::string &value )
+{
+    for( const char c : value ) {
+        hash ^= static_cast<unsigned char>( c );
+        hash *= 0x100000001b3ULL;
+    }
+    // Separator, so that "ab" + "c" and "a" + "bc" differ
+    hash ^= 0xff;
+    hash *= 0x100000001b3ULL;
+}
+
+// Size and modification time of a file, only the time for directories, empty if it's missing
+static std::string file_stamp( const std::string &file )
+{
+    const std::filesystem::path fs_path( file );
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time( fs_path, ec );
+    if( ec ) {
+        return std::string();
+    }
+    const std::string time = std::to_string( mtime.time_since_epoch().count() );
+    if( std::filesystem::is_directory( fs_path, ec ) ) {
+        return time;
+    }
+    const auto size = std::filesystem::file_size( fs_path, ec );
+    return ec ? std::string() : std::to_string( size ) + ":" + time;
+}
+
+static void write_string( std::string &out, std::string_view value )
+{
+    write_varint( out, value.size() );
+    out.append( value );
+}
+
+static std::string_view read_string( binary_reader &in )
+{
+    return in.read_bytes( in.read_varint() );
+}
+
+static std::string snapshot_path( const std::string &key )
+{
+    return PATH_INFO::data_cache_dir() + "data-" + key + ".bin";
+}
+
+data_snapshot::data_snapshot( const std::vector<mod_id> &packs )
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    hash_string( hash, getVersionString() );
+    for( const mod_id &pack : packs ) {
+        hash_string( hash, pack.str() );
+        hash_string( hash, pack->path );
+        pack_paths.push_back( pack->path );
+    }
+    key = string_format( "%016llx", static_cast<unsigned long long>( hash ) );
+}
+
+bool data_snapshot::load()
+{
+    contents.clear();
+    files.clear();
+    loaded = !rebuild_data_snapshot && read_snapshot();
+    if( !loaded ) {
+        contents.clear();
+        files.clear();
+        for( const std::string &path : pack_paths ) {
+            files[path] = DynamicDataLoader::get_data_files( path );
+        }
+    }
+    return loaded;
+}
+
+bool data_snapshot::read_snapshot()
+{
+    const std::string path = snapshot_path( key );
+    if( !file_exist( path ) ) {
+        return false;
+    }
+    const std::string data = read_entire_file( path );
+    try {
+        binary_reader in( data );
+        if( in.read_bytes( snapshot_magic.size() ) != snapshot_magic ||
+            in.read_varint() != snapshot_version || read_string( in ) != key ) {
+            throw std::runtime_error( "not a snapshot of this data" );
+        }
+        const std::uint32_t stamp_count = in.read_varint();
+        for( std::uint32_t i = 0; i < stamp_count; i++ ) {
+            const std::string file( read_string( in ) );
+            if( read_string( in ) != file_stamp( file ) ) {
+                DebugLog( DL::Info, DC::Main ) << "Data snapshot " << path << " is out of date, " << file <<
+                                               " changed";
+                return false;
+            }
+        }
+        const std::uint32_t pack_count = in.read_varint();
+        for( std::uint32_t i = 0; i < pack_count; i++ ) {
+            std::vector<std::string> &pack_files = files[std::string( read_string( in ) )];
+            const std::uint32_t file_count = in.read_varint();
+            for( std::uint32_t j = 0; j < file_count; j++ ) {
+                const std::string_view file = read_string( in );
+                pack_files.emplace_back( file );
+                contents.emplace( file, read_string( in ) );
+            }
+        }
+    } catch( const std::exception &err ) {
+        DebugLog( DL::Warn, DC::Main ) << "Ignoring data snapshot " << path << ": " << err.what();
+        return false;
+    }
+    return true;
+}
+
+void data_snapshot::save() const
+{
+    std::vector<std::pair<std::string, std::string>> stamps;
+    std::string packs;
+    write_varint( packs, pack_paths.size() );
+    for( const std::string &path : pack_paths ) {
+        std::error_code ec;
+        if( std::filesystem::is_directory( std::filesystem::path( path ), ec ) ) {
+            stamps.emplace_back( path, file_stamp( path ) );
+            for( std::filesystem::recursive_directory_iterator it( std::filesystem::path( path ), ec ), end;
+                 !ec && it != end; it.increment( ec ) ) {
+                if( it->is_directory( ec ) ) {
+                    const std::string dir = it->path().generic_string();
+                    stamps.emplace_back( dir, file_stamp( dir ) );
+                }
+            }
+        }
+        // Lua scripts aren't part of the snapshot, but they can break the data too
+        for( const std::string &file : get_files_from_path( ".lua", path, true, true ) ) {
+            stamps.emplace_back( file, file_stamp( file ) );
+        }
+        const std::vector<std::string> pack_files = DynamicDataLoader::get_data_files( path );
+        write_string( packs, path );
+        write_varint( packs, pack_files.size() );
+        for( const std::string &file : pack_files ) {
+            // Before reading it, so that changes while reading make the snapshot out of date
+            stamps.emplace_back( file, file_stamp( file ) );
+            write_string( packs, file );
+            write_string( packs, read_entire_file( file ) );
+        }
+    }
+
+    std::string data;
+    data.append( snapshot_magic );
+    write_varint( data, snapshot_version );
+    write_string( data, key );
+    write_varint( data, stamps.size() );
+    for( const auto &stamp : stamps ) {
+        write_string( data, stamp.first );
+        write_string( data, stamp.second );
+    }
+    data.append( packs );
+
+    const std::string dir = PATH_INFO::data_cache_dir();
+    const bool written = assure_dir_exist( dir ) &&
+    write_to_file( snapshot_path( key ), [&]( std::ostream & fout ) {
+        fout << data;
+    }, nullptr );
+    if( !written ) {
+        DebugLog( DL::Warn, DC::Main ) << "Failed to write data snapshot to " << dir;
+        return;
+    }
+
+    // Drop the least recently written snapshots
+    std::vector<std::string> snapshots = get_files_from_path( ".bin", dir, false, true );
+    if( snapshots.size() > max_snapshots ) {
+        std::vector<std::pair<std::filesystem::file_time_type, std::string>> by_age;
+        for( const std::string &snapshot : snapshots ) {
+            std::error_code ec;
+            by_age.emplace_back( std::filesystem::last_write_time( std::filesystem::path( snapshot ), ec ),
+                                 snapshot );
+        }
+        std::sort( by_age.begin(), by_age.end() );
+        for( size_t i = 0; i + max_snapshots < by_age.size(); i++ ) {
+            remove_file( by_age[i].second );
+        }
+    }
+}
+
+size_t data_snapshot::file_count() const
+{
+    size_t total = 0;
+    for( const auto &pack : files ) {
+        total += pack.second.size();
+    }
+    return total;
+}
+
+const std::vector<std::string> &data_snapshot::files_in( const std::string &path ) const
+{
+    static const std::vector<std::string> none;
+    const auto it = files.find( path );
+    return it != files.end() ? it->second : none;
+}
+
+const std::string *data_snapshot::contents_of( const std::string &file ) const
+{
+    const auto it = contents.find( file );
+    return it != contents.end() ? &it->second : nullptr;
+}
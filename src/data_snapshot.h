@@ -0,0 +1,68 @@
+#pragma once
+#ifndef CATA_SRC_DATA_SNAPSHOT_H
+#define CATA_SRC_DATA_SNAPSHOT_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "type_id.h"
+
+/** Set by the --rebuild-data-cache command line switch, existing snapshots are ignored. */
+extern bool rebuild_data_snapshot;
+/** Tests load content packs from their files, unless this is set. */
+extern bool use_data_snapshot_in_tests;
+
+/**
+ * All data files of a list of content packs, stored in a single cache file, so that loading
+ * them doesn't have to list the data directories and open thousands of files.
+ *
+ * A snapshot is found by a key made from the game version and the content packs in load
+ * order.  It stores a manifest with the modification times of every data directory and the
+ * size and modification time of every data file and Lua script, and is only used if they
+ * all still match, so any change to the data makes the loader go back to the files on disk.
+ * Adding or removing a file changes the modification time of its directory, so checking
+ * the manifest doesn't have to list the directories again.
+ */
+class data_snapshot
+{
+    public:
+        explicit data_snapshot( const std::vector<mod_id> &packs );
+
+        const std::string &get_key() const {
+            return key;
+        }
+
+        /**
+         * Reads the snapshot with this key from the cache directory and checks its manifest
+         * against the files on disk.  If there's no up to date snapshot, or if
+         * @ref rebuild_data_snapshot is set, the data files are listed from disk instead.
+         * @return whether the snapshot was loaded.
+         */
+        bool load();
+        /** Reads the files from disk and writes them to the cache directory. */
+        void save() const;
+
+        bool is_loaded() const {
+            return loaded;
+        }
+
+        /** Data files under @p path, in the order they are loaded in.  Filled by @ref load. */
+        const std::vector<std::string> &files_in( const std::string &path ) const;
+        /** Contents of a data file, nullptr if the snapshot wasn't loaded. */
+        const std::string *contents_of( const std::string &file ) const;
+
+        size_t file_count() const;
+
+    private:
+        std::string key;
+        std::vector<std::string> pack_paths;
+        bool loaded = false;
+        // Content pack paths to their files
+        std::map<std::string, std::vector<std::string>> files;
+        std::unordered_map<std::string, std::string> contents;
+
+        bool read_snapshot();
+};
+#endif // CATA_SRC_DATA_SNAPSHOT_H
@@ -45,6 +45,7 @@
 #include "enums.h"
 #include "faction.h"
 #include "filesystem.h"
+#include "fstream_utils.h"
 #include "game.h"
 #include "game_constants.h"
 #include "game_inventory.h"
@@ -77,6 +78,7 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -92,6 +94,7 @@
 #include "string_utils.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -187,6 +190,8 @@ enum debug_menu_index {
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_VEHICLE_EXPORT_JSON,
     DEBUG_HOUR_TIMER,
+    DEBUG_TURN_PROFILER,
+    DEBUG_TURN_PROFILE_TRACE,
     DEBUG_NESTED_MAPGEN,
     DEBUG_RESET_IGNORED_MESSAGES,
     DEBUG_RELOAD_TILES,
@@ -238,6 +243,8 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER, true, 'P', _( "Toggle turn profiler" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILE_TRACE, true, 'x', _( "Write turn profile as Chrome trace" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -1442,7 +1449,7 @@ void debug()
             for( int i = 0; i < OMAPX; i++ ) {
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int k = -OVERMAP_DEPTH; k <= OVERMAP_HEIGHT; k++ ) {
-                        cur_om.seen( { i, j, k } ) = true;
+                        cur_om.set_seen( { i, j, k }, true );
                     }
                 }
             }
@@ -1867,6 +1874,19 @@ void debug()
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case DEBUG_TURN_PROFILER:
+            turn_profiler::set_enabled( !turn_profiler::is_enabled() );
+            add_msg( turn_profiler::is_enabled() ?
+                     _( "Turn profiler started, enable the Turn Profile sidebar panel to see it." ) :
+                     _( "Turn profiler stopped." ) );
+            break;
+        case DEBUG_TURN_PROFILE_TRACE: {
+            const std::string path = PATH_INFO::turn_profile();
+            if( write_to_file( path, turn_profiler::write_chrome_trace, _( "turn profile" ) ) ) {
+                popup( _( "Wrote the zones recorded by the turn profiler to %s" ), path );
+            }
+            break;
+        }
         case DEBUG_CHANGE_TIME: {
             auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
                 const auto text = string_input_popup()
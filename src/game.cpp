@@ -162,6 +162,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -1359,7 +1360,10 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // Only missing when turns are run without starting a game, like in benchmarks
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
 
@@ -1451,7 +1455,13 @@ bool game::do_turn()
                     queue_screenshot = false;
                 }
 
-                if( handle_action() ) {
+                bool acted = false;
+                {
+                    // Includes waiting for input
+                    CATA_TURN_ZONE( "player_action" );
+                    acted = handle_action();
+                }
+                if( acted ) {
                     ++moves_since_last_save;
                 }
 
@@ -1597,6 +1607,7 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
+    turn_profiler::end_turn( calendar::turn );
     return false;
 }
 
@@ -2673,7 +2684,9 @@ bool game::save_maps()
     try {
         m.save();
         overmap_buffer.save(); // can throw
-        MAPBUFFER.save(); // can throw
+        MAPBUFFER.save();
+        // Quads are written in the background, wait for them to be on disk
+        MAPBUFFER.flush(); // can throw
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -4087,6 +4100,7 @@ void game::cleanup_dead()
 void game::monmove()
 {
     ZoneScoped;
+    CATA_TURN_ZONE( "monmove" );
     cleanup_dead();
 
     for( monster &critter : all_monsters() ) {
@@ -4168,6 +4182,7 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    const npc_ai::perception_snapshot npc_perception;
     for( npc &guy : g->all_npcs() ) {
         int turns = 0;
         if( guy.is_mounted() ) {
@@ -10759,6 +10774,34 @@ point game::update_map( player &p )
     return update_map( p2.x, p2.y );
 }
 
+// Starts reading the submaps the map is about to shift onto in the background, so that the next
+// shift in the same direction does not have to wait for the disk.  Vehicles cross a submap every
+// turn at about 27 mph, so fast ones look further ahead.
+static void prefetch_submaps_ahead( const map &here, const player &u, const point &shift )
+{
+    int lookahead = 1;
+    if( const optional_vpart_position vp = here.veh_at( u.pos() ) ) {
+        lookahead += std::min( std::abs( vp->vehicle().velocity ) / 2700, 3 );
+    }
+    const tripoint abs_sub = here.get_abs_sub();
+    const int zmin = here.has_zlevels() ? -OVERMAP_DEPTH : abs_sub.z;
+    const int zmax = here.has_zlevels() ? OVERMAP_HEIGHT : abs_sub.z;
+    for( int step = 0; step < lookahead; step++ ) {
+        for( int i = 0; i < MAPSIZE; i++ ) {
+            for( int z = zmin; z <= zmax; z++ ) {
+                if( shift.x != 0 ) {
+                    const int x = shift.x > 0 ? abs_sub.x + MAPSIZE + step : abs_sub.x - 1 - step;
+                    MAPBUFFER.prefetch( tripoint( x, abs_sub.y + i, z ) );
+                }
+                if( shift.y != 0 ) {
+                    const int y = shift.y > 0 ? abs_sub.y + MAPSIZE + step : abs_sub.y - 1 - step;
+                    MAPBUFFER.prefetch( tripoint( abs_sub.x + i, y, z ) );
+                }
+            }
+        }
+    }
+}
+
 point game::update_map( int &x, int &y )
 {
     point shift;
@@ -10828,6 +10871,12 @@ point game::update_map( int &x, int &y )
     // as "current z-level"
     u.setpos( tripoint( x, y, get_levz() ) );
 
+    prefetch_submaps_ahead( m, u, shift );
+    // So that walking into the next overmap doesn't wait for it to be generated from scratch
+    overmap_buffer.prefetch_around( project_to<coords::om>( u.global_omt_location().xy() ) );
+    // Nothing but the main map holds submaps between turns, so it's safe to unload them here
+    MAPBUFFER.unload_least_recently_touched( get_option<int>( "LOADED_SUBMAP_LIMIT" ) );
+
     // Only do the loading after all coordinates have been shifted.
 
     // Check for overmap saved npcs that should now come into view.
@@ -1,16 +1,32 @@
 #include "init.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.mutex.h"
+#   include "mingw.condition_variable.h"
+#   include "mingw.thread.h"
+#endif
+
 #include "achievement.h"
 #include "activity_type.h"
 #include "ammo.h"
@@ -21,6 +37,7 @@
 #include "behavior.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "catalua.h"
 #include "cata_utility.h"
 #include "clothing_mod.h"
@@ -32,6 +49,7 @@
 #include "crafting_gui.h"
 #include "creature.h"
 #include "cursesdef.h"
+#include "data_snapshot.h"
 #include "debug.h"
 #include "dependency_tree.h"
 #include "dialogue.h"
@@ -468,16 +486,113 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
-void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+namespace
 {
-    assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
-    // We assume that each folder is consistent in itself,
-    // and all the previously loaded folders.
-    // E.g. the core might provide a vpart "frame-x"
-    // the first loaded mode might provide a vehicle that uses that frame
-    // But not the other way round.
 
+struct preloaded_data_file {
+    // Empty if the file couldn't be read, the main thread tries again and reports the error
+    std::optional<std::string> contents;
+    bool ready = false;
+};
+
+/**
+ * Reads data files on worker threads, in the order they are loaded in, so that the main thread
+ * only has to wait for the first file and can then parse and load the objects in order while
+ * the rest is read.  Syntax errors are left to the main thread, checking the files here would
+ * parse all of them twice.
+ */
+class data_file_preloader
+{
+    public:
+        explicit data_file_preloader( const std::vector<std::string> &files ) : files( files ),
+            preloaded( files.size() ) {
+            const size_t thread_count = std::min<size_t>( files.size(),
+                                        std::clamp( std::thread::hardware_concurrency(), 1u, 8u ) );
+            for( size_t i = 0; i < thread_count; i++ ) {
+                threads.emplace_back( &data_file_preloader::run, this );
+            }
+        }
+
+        ~data_file_preloader() {
+            // Files after an error aren't needed anymore
+            next_file = files.size();
+            for( std::thread &thread : threads ) {
+                thread.join();
+            }
+        }
+
+        preloaded_data_file &wait_for( size_t index ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            file_ready.wait( lock, [&]() {
+                return preloaded[index].ready;
+            } );
+            return preloaded[index];
+        }
+
+        // Time spent reading, summed over all threads
+        std::chrono::steady_clock::duration get_reading_time() const {
+            return std::chrono::steady_clock::duration( reading.load() );
+        }
+
+        int get_thread_count() const {
+            return threads.size();
+        }
+
+    private:
+        void run() {
+            for( size_t index = next_file++; index < files.size(); index = next_file++ ) {
+                const std::string &file = files[index];
+                preloaded_data_file result;
+                const auto start = std::chrono::steady_clock::now();
+                cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
+                if( infile.is_open() ) {
+                    result.contents.emplace( ( std::istreambuf_iterator<char>( *infile ) ),
+                                             std::istreambuf_iterator<char>() );
+                }
+                reading += ( std::chrono::steady_clock::now() - start ).count();
+
+                std::lock_guard<std::mutex> lock( mutex );
+                preloaded[index] = std::move( result );
+                preloaded[index].ready = true;
+                file_ready.notify_all();
+            }
+        }
+
+        const std::vector<std::string> &files;
+        std::vector<preloaded_data_file> preloaded;
+        std::atomic<size_t> next_file{ 0 };
+        std::atomic<std::int64_t> reading{ 0 };
+        std::mutex mutex;
+        std::condition_variable file_ready;
+        std::vector<std::thread> threads;
+};
+
+double seconds( std::chrono::steady_clock::duration d )
+{
+    return std::chrono::duration<double>( d ).count();
+}
+
+// Runs the steps of a loading stage, showing how long each of them took
+void run_timed_entries( loading_ui &ui,
+                        const std::vector<std::pair<std::string, std::function<void()>>> &entries )
+{
+    for( const auto &e : entries ) {
+        ui.add_entry( e.first );
+    }
+
+    ui.show();
+    for( const auto &e : entries ) {
+        const auto start = std::chrono::steady_clock::now();
+        e.second();
+        ui.set_entry_note( string_format( "%.2fs", seconds( std::chrono::steady_clock::now() - start ) ) );
+        ui.proceed();
+    }
+}
+
+} // namespace
+
+auto DynamicDataLoader::get_data_files( const std::string &path ) -> str_vec
+{
     // get a list of all files in the directory
     str_vec files = get_files_from_path( ".json", path, true, true );
     if( files.empty() ) {
@@ -488,25 +603,69 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+    return files;
+}
+
+void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
+        loading_ui &ui )
+{
+    assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
+    // We assume that each folder is consistent in itself,
+    // and all the previously loaded folders.
+    // E.g. the core might provide a vpart "frame-x"
+    // the first loaded mode might provide a vehicle that uses that frame
+    // But not the other way round.
+
+    const str_vec files = snapshot != nullptr ? snapshot->files_in( path ) : get_data_files( path );
+    // Files in the snapshot don't have to be read and were already checked
+    std::optional<data_file_preloader> preloader;
+    if( snapshot == nullptr || !snapshot->is_loaded() ) {
+        preloader.emplace( files );
+    }
+    std::chrono::steady_clock::duration waiting{};
+    std::chrono::steady_clock::duration loading{};
     // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    for( size_t i = 0; i < files.size(); i++ ) {
+        const std::string &file = files[i];
+        auto start = std::chrono::steady_clock::now();
+        // Parsed in place, the snapshot keeps its contents until loading is done
+        const std::string *cached = snapshot != nullptr ? snapshot->contents_of( file ) : nullptr;
+        std::optional<std::string> contents;
+        if( cached == nullptr && preloader ) {
+            contents = std::move( preloader->wait_for( i ).contents );
+        }
+        if( cached == nullptr && !contents ) {
+            // open the file as a stream
+            cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
+            // and stuff it into ram
+            contents.emplace( ( std::istreambuf_iterator<char>( *infile ) ),
+                              std::istreambuf_iterator<char>() );
+        }
+        const auto loading_start = std::chrono::steady_clock::now();
+        waiting += loading_start - start;
         try {
             // parse it
-            JsonIn jsin( iss, file );
+            JsonIn jsin( cached != nullptr ? *cached : *contents, file );
             load_all_from_json( jsin, src, ui, path, file );
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
+        loading += std::chrono::steady_clock::now() - loading_start;
+    }
+
+    if( preloader ) {
+        DebugLog( DL::Info, DC::Main ) << string_format(
+                                           "Loaded %d data files from %s: reading %.3fs on %d threads, "
+                                           "waiting for them %.3fs, loading %.3fs", files.size(), path,
+                                           seconds( preloader->get_reading_time() ), preloader->get_thread_count(),
+                                           seconds( waiting ), seconds( loading ) );
+        ui.set_entry_note( string_format( _( "%.2fs waiting for files, %.2fs loading" ), seconds( waiting ),
+                                          seconds( loading ) ) );
+    } else {
+        DebugLog( DL::Info, DC::Main ) << string_format(
+                                           "Loaded %d data files from %s from the data snapshot: loading %.3fs",
+                                           files.size(), path, seconds( waiting + loading ) );
+        ui.set_entry_note( string_format( _( "%.2fs loading" ), seconds( waiting + loading ) ) );
     }
 }
 
@@ -721,15 +880,7 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
         }
     };
 
-    for( const named_entry &e : entries ) {
-        ui.add_entry( e.first );
-    }
-
-    ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_timed_entries( ui, entries );
 }
 
 void DynamicDataLoader::check_consistency( loading_ui &ui )
@@ -816,15 +967,7 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
         }
     };
 
-    for( const named_entry &e : entries ) {
-        ui.add_entry( e.first );
-    }
-
-    ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
-        ui.proceed();
-    }
+    run_timed_entries( ui, entries );
 
     finalized = true;
 }
@@ -887,6 +1030,17 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
 
     cata::reg_lua_iuse_actors( *loader.lua, *item_controller );
 
+    // Tests and mod checks read the files themselves, unless a test is about snapshots
+    std::optional<data_snapshot> snapshot;
+    if( !test_mode || use_data_snapshot_in_tests ) {
+        snapshot.emplace( available );
+        snapshot->load();
+        loader.use_snapshot( &*snapshot );
+    }
+    on_out_of_scope stop_using_snapshot( [&]() {
+        loader.use_snapshot( nullptr );
+    } );
+
     for( const mod_id &mod : available ) {
         loader.load_data_from_path( mod->path, mod.str(), ui );
         ui.proceed();
@@ -903,7 +1057,12 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
         }
     }
 
+    // Not skipped for snapshots, some checks also fill in data that depends on other types
     loader.check_consistency( ui );
+    // Only data without errors is saved, so that there's a snapshot of the data that's in use
+    if( snapshot && !snapshot->is_loaded() && !debug_has_error_been_observed() ) {
+        snapshot->save();
+    }
 
     if( cata::has_lua() ) {
         init::load_main_lua_scripts( *loader.lua, packs );
@@ -14,6 +14,7 @@
 #include "memory_fast.h"
 #include "type_id.h"
 
+class data_snapshot;
 class loading_ui;
 class JsonObject;
 class JsonIn;
@@ -76,6 +77,9 @@ class DynamicDataLoader
         struct cached_streams;
         std::unique_ptr<cached_streams> stream_cache;
 
+        // Data files are read from this instead of the disk if set
+        const data_snapshot *snapshot = nullptr;
+
         /**
          * Maps the type string (coming from json) to the
          * functor that loads that kind of object from json.
@@ -140,6 +144,17 @@ class DynamicDataLoader
         /*@{*/
         void load_data_from_path( const std::string &path, const std::string &src, loading_ui &ui );
         /*@}*/
+        /**
+         * The files @ref load_data_from_path loads from @p path, in order.
+         */
+        static str_vec get_data_files( const std::string &path );
+        /**
+         * Makes @ref load_data_from_path read data files from @p data instead of the disk,
+         * nullptr to go back to the disk.
+         */
+        void use_snapshot( const data_snapshot *data ) {
+            snapshot = data;
+        }
         /**
          * Deletes and unloads all the data previously loaded with
          * @ref load_data_from_path
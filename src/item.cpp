@@ -5971,6 +5971,20 @@ auto get_hourly_rotpoints_at_temp( const units::temperature temp ) -> int
     return rot_chart[std::round( temp_c )];
 }
 
+// rot modifier
+static float rot_factor( const item &it )
+{
+    if( it.is_corpse() && it.has_flag( flag_FIELD_DRESS ) ) {
+        return 0.75;
+    }
+    return 1.0;
+}
+
+static time_duration rot_over( float factor, time_duration time_delta, units::temperature temp )
+{
+    return factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+}
+
 auto item::calc_rot( time_point time, const units::temperature temp ) const -> time_duration
 {
     // Avoid needlessly calculating already rotten things.  Corpses should
@@ -5981,12 +5995,6 @@ auto item::calc_rot( time_point time, const units::temperature temp ) const -> t
         return 0_seconds;
     }
 
-    // rot modifier
-    float factor = 1.0;
-    if( is_corpse() && has_flag( flag_FIELD_DRESS ) ) {
-        factor = 0.75;
-    }
-
     time_duration added_rot = 0_seconds;
     // simulation of different age of food at the start of the game and good/bad storage
     // conditions by applying starting variation bonus/penalty of +/- 20% of base shelf-life
@@ -5997,7 +6005,7 @@ auto item::calc_rot( time_point time, const units::temperature temp ) const -> t
         added_rot += rng( -spoil_variation, spoil_variation );
     }
     time_duration time_delta = time - last_rot_check;
-    added_rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+    added_rot += rot_over( rot_factor( *this ), time_delta, temp );
     return added_rot;
 }
 
@@ -9398,6 +9406,50 @@ static units::temperature clip_by_temperature_flag( units::temperature temperatu
     return temperature;
 }
 
+// Temperature at a past time, for items that were outside of the reality bubble
+static units::temperature past_temperature( const weather_manager &weather, const tripoint &pos,
+        time_point time, units::temperature local_mod, temperature_flag flag )
+{
+    //Use weather if above ground, use map temp if below
+    units::temperature env_temperature_raw;
+    if( pos.z >= 0 ) {
+        tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
+        units::temperature weather_temperature = weather.get_cur_weather_gen().get_weather_temperature(
+                    location, time, calendar::config, g->get_seed() );
+        env_temperature_raw = weather_temperature + local_mod;
+    } else {
+        env_temperature_raw = temperatures::annual_average + local_mod;
+    }
+
+    return clip_by_temperature_flag( env_temperature_raw, flag );
+}
+
+/**
+ * Rot of an item over @p hours full hours starting at @p first_hour, element i is the rot after
+ * i hours.  Cached in the weather manager, so that weather is only calculated once for all
+ * items at the same location.  Weather depends on the exact location, so that's the key,
+ * except underground where the temperature is always the same.
+ */
+static const std::vector<time_duration> &hourly_rot_sums( const weather_manager &weather,
+        const tripoint &pos, time_point first_hour, int hours, units::temperature local_mod,
+        temperature_flag flag, float factor )
+{
+    const bool underground = pos.z < 0;
+    std::vector<time_duration> &sums = weather.rot_catchup_cache[std::make_tuple(
+            underground ? tripoint_min : get_map().getabs( pos ),
+            underground ? 0 : to_turn<int>( first_hour ),
+            units::to_millidegree_celsius( local_mod ), static_cast<int>( flag ), factor )];
+    if( sums.empty() ) {
+        sums.push_back( 0_turns );
+    }
+    for( int hour = static_cast<int>( sums.size() ); hour <= hours; hour++ ) {
+        const time_point time = first_hour + ( hour - 1 ) * 1_hours;
+        sums.push_back( sums.back() + rot_over( factor, 1_hours,
+                                                past_temperature( weather, pos, time, local_mod, flag ) ) );
+    }
+    return sums;
+}
+
 detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool seals,
                                        const tripoint &pos,
                                        player *carrier, const temperature_flag flag,
@@ -9428,38 +9480,62 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = weather.get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
         // It's a modifier, so we need to subtract 0_f
         units::temperature local_mod = units::from_fahrenheit( g->new_game
                                        ? 0
                                        : get_map().get_temperature( pos ) ) - 0_f;
 
         // Process the past of this item since the last time it was processed
-        while( now - time > 1_hours ) {
-            // Get the environment temperature
+        const auto process_hour = [&]() {
             time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
             time += time_delta;
 
-            //Use weather if above ground, use map temp if below
-            units::temperature env_temperature_raw;
-            if( pos.z >= 0 ) {
-                tripoint_abs_ms location = tripoint_abs_ms( get_map().getabs( pos ) );
-                units::temperature weather_temperature = wgen.get_weather_temperature( location, time,
-                        calendar::config, seed );
-                env_temperature_raw = weather_temperature + local_mod;
-            } else {
-                env_temperature_raw = temperatures::annual_average + local_mod;
-            }
+            // Calculate item rot
+            self->rot += self->calc_rot( time, past_temperature( weather, pos, time, local_mod, flag ) );
+            self->last_rot_check = time;
 
-            units::temperature env_temperature_clipped = clip_by_temperature_flag( env_temperature_raw, flag );
+            // No need to track item that will be gone
+            return !( self->has_rotten_away() && carrier == nullptr && !seals );
+        };
 
-            // Calculate item rot
-            self->rot += self->calc_rot( time, env_temperature_clipped );
+        // The first check after the start of the cataclysm adds a random spoil variation
+        while( now - time > 1_hours && self->last_rot_check <= calendar::start_of_cataclysm ) {
+            if( !process_hour() ) {
+                return detached_ptr<item>();
+            }
+        }
+
+        // Full hours are looked up in a table shared with all items stored in the same place
+        const int full_hours = now - time > 1_hours ? to_hours<int>( now - time - 1_hours ) : 0;
+        if( full_hours > 0 ) {
+            const std::vector<time_duration> &rot_sums = hourly_rot_sums( weather, pos, time + 1_hours,
+                    full_hours, local_mod, flag, rot_factor( *self ) );
+            const time_duration start_rot = self->rot;
+            // calc_rot stops adding rot to food that is rotten enough, find the hour when that happens
+            int rotting_hours = 0;
+            int last_hour = full_hours;
+            while( rotting_hours < last_hour ) {
+                const int hour = ( rotting_hours + last_hour ) / 2;
+                self->rot = start_rot + rot_sums[hour];
+                if( !self->is_corpse() && self->get_relative_rot() > 2.0 ) {
+                    last_hour = hour;
+                } else {
+                    rotting_hours = hour + 1;
+                }
+            }
+            self->rot = start_rot + rot_sums[rotting_hours];
+            time += full_hours * 1_hours;
             self->last_rot_check = time;
 
+            // Rot only grows, so if the item has rotten away now it did so in one of the hours
             if( self->has_rotten_away() && carrier == nullptr && !seals ) {
-                // No need to track item that will be gone
+                return detached_ptr<item>();
+            }
+        }
+
+        // Remaining partial hour
+        while( now - time > 1_hours ) {
+            if( !process_hour() ) {
                 return detached_ptr<item>();
             }
         }
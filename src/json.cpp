@@ -87,10 +87,9 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        if( positions.contains( n ) ) {
+        if( !positions.try_emplace( std::move( n ), p ).second ) {
             j.error( "duplicate entry in json object" );
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end_ = jsin->tell();
@@ -809,6 +808,47 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+json_memory_buffer::json_memory_buffer( std::string_view data )
+{
+    char *begin = const_cast<char *>( data.data() );
+    setg( begin, begin, begin + data.size() );
+}
+
+json_memory_buffer::pos_type json_memory_buffer::seekoff( off_type off,
+        std::ios_base::seekdir dir, std::ios_base::openmode which )
+{
+    const off_type size = egptr() - eback();
+    off_type target = off;
+    if( dir == std::ios_base::cur ) {
+        target += gptr() - eback();
+    } else if( dir == std::ios_base::end ) {
+        target += size;
+    }
+    if( !( which & std::ios_base::in ) || target < 0 || target > size ) {
+        return pos_type( off_type( -1 ) );
+    }
+    setg( eback(), eback() + target, egptr() );
+    return pos_type( target );
+}
+
+json_memory_buffer::pos_type json_memory_buffer::seekpos( pos_type pos,
+        std::ios_base::openmode which )
+{
+    return seekoff( off_type( pos ), std::ios_base::beg, which );
+}
+
+// Whether the text can be copied as it is, i.e. it has no escapes, control characters or utf8
+// sequences that would need to be checked.  Written without branches so it vectorizes.
+static bool is_plain_string( std::string_view text )
+{
+    bool special = false;
+    for( const char ch : text ) {
+        const unsigned char uc = static_cast<unsigned char>( ch );
+        special |= ( uc < 0x20 ) | ( uc >= 0x80 ) | ( uc == '\\' );
+    }
+    return !special;
+}
+
 int JsonIn::tell()
 {
     return stream->tellg();
@@ -831,6 +871,14 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( json_memory_buffer *buf = scannable() ) {
+        const char *p = buf->current();
+        while( p != buf->end() && is_whitespace( *p ) ) {
+            ++p;
+        }
+        buf->advance_to( p );
+    }
+    // Sets eof when the end was reached, same as reading from a stream
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -911,6 +959,16 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
+    if( json_memory_buffer *buf = scannable() ) {
+        const std::string_view rest( buf->current(), buf->end() - buf->current() );
+        const size_t close = rest.find( '"', 1 );
+        if( !rest.empty() && rest.front() == '"' && close != std::string_view::npos &&
+            rest.substr( 0, close ).find_first_of( "\\\r\n" ) == std::string_view::npos ) {
+            buf->advance_to( rest.data() + close + 1 );
+            end_value();
+            return;
+        }
+    }
     stream->get( ch );
     if( ch != '"' ) {
         std::stringstream err;
@@ -1024,6 +1082,19 @@ void JsonIn::skip_number()
 {
     char ch;
     eat_whitespace();
+    if( json_memory_buffer *buf = scannable() ) {
+        const char *p = buf->current();
+        while( p != buf->end() && ( *p == '+' || *p == '-' || ( *p >= '0' && *p <= '9' ) ||
+                                    *p == 'e' || *p == 'E' || *p == '.' ) ) {
+            ++p;
+        }
+        // Numbers at the very end are left to the stream, so that it sets eof
+        if( p != buf->end() ) {
+            buf->advance_to( p );
+            end_value();
+            return;
+        }
+    }
     // skip all of (+-0123456789.eE)
     while( stream->good() ) {
         stream->get( ch );
@@ -1180,6 +1251,19 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
 std::string JsonIn::get_string()
 {
     eat_whitespace();
+    if( json_memory_buffer *buf = scannable() ) {
+        const std::string_view rest( buf->current(), buf->end() - buf->current() );
+        const size_t close = rest.find( '"', 1 );
+        if( !rest.empty() && rest.front() == '"' && close != std::string_view::npos ) {
+            const std::string_view text = rest.substr( 1, close - 1 );
+            // Anything else goes through the checks below
+            if( is_plain_string( text ) ) {
+                buf->advance_to( rest.data() + close + 1 );
+                end_value();
+                return std::string( text );
+            }
+        }
+    }
     std::string s;
     char ch;
     std::string err;
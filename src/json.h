@@ -8,9 +8,12 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -85,6 +88,31 @@ struct number_sci_notation {
     int64_t exp = 0;
 };
 
+/**
+ * Stream buffer over a block of memory, which is not copied and has to outlive it.
+ * @ref JsonIn scans such buffers directly instead of reading them one character at a time.
+ */
+class json_memory_buffer : public std::streambuf
+{
+    public:
+        explicit json_memory_buffer( std::string_view data );
+
+        const char *current() const {
+            return gptr();
+        }
+        const char *end() const {
+            return egptr();
+        }
+        void advance_to( const char *p ) {
+            setg( eback(), const_cast<char *>( p ), egptr() );
+        }
+
+    protected:
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override;
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override;
+};
+
 /* JsonIn
  * ======
  *
@@ -168,10 +196,24 @@ struct number_sci_notation {
 class JsonIn
 {
     private:
+        struct memory_stream {
+            json_memory_buffer buffer;
+            std::istream stream;
+
+            explicit memory_stream( std::string_view data ) : buffer( data ), stream( &buffer ) {}
+        };
+
+        // Set when reading from memory
+        std::unique_ptr<memory_stream> memory;
         std::istream *stream;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
 
+        // Buffer that can be scanned directly, if the stream is in a good state
+        json_memory_buffer *scannable() {
+            return memory && stream->good() ? &memory->buffer : nullptr;
+        }
+
         void skip_separator();
         void skip_pair_separator();
         void end_value();
@@ -184,6 +226,12 @@ class JsonIn
             : stream( &s ), path( loc.path ) {
             seek( loc.offset );
         }
+        /** Reads from @p data, which is not copied, so it has to outlive this. */
+        explicit JsonIn( std::string_view data )
+            : memory( std::make_unique<memory_stream>( data ) ), stream( &memory->stream ) {}
+        JsonIn( std::string_view data, const std::string &path )
+            : memory( std::make_unique<memory_stream>( data ) ), stream( &memory->stream ),
+              path( make_shared_fast<std::string>( path ) ) {}
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
 
@@ -1,11 +1,15 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <array>
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -29,6 +33,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "player.h"
 #include "point.h"
 #include "profile.h"
@@ -635,12 +640,56 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint cache_start( 0, 0, zlev );
-    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    const auto apply_all_light_sources = [&]() {
+        const tripoint cache_start( 0, 0, zlev );
+        const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( light_source_buffer[p.x][p.y] > 0.0 ) {
+                apply_light_source( p, light_source_buffer[p.x][p.y] );
+            }
+        }
+    };
+    const std::string lightmap_mode = get_option<std::string>( "LIGHTMAP_MODE" );
+    if( lightmap_mode == "full" ) {
+        apply_all_light_sources();
+    } else if( lightmap_mode == "compare" ) {
+        // Keep the result of the full rebuild, but complain if the incremental one differs
+        struct lightmap_copy {
+            four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+            float sm[MAPSIZE_X][MAPSIZE_Y];
+        };
+        const auto lm_before = std::make_unique<lightmap_copy>();
+        std::memcpy( lm_before->lm, lm, sizeof( lm ) );
+        std::memcpy( lm_before->sm, sm, sizeof( sm ) );
+        apply_light_sources_incremental( zlev );
+        const auto lm_incremental = std::make_unique<lightmap_copy>();
+        std::memcpy( lm_incremental->lm, lm, sizeof( lm ) );
+        std::memcpy( lm_incremental->sm, sm, sizeof( sm ) );
+        std::memcpy( lm, lm_before->lm, sizeof( lm ) );
+        std::memcpy( sm, lm_before->sm, sizeof( sm ) );
+        apply_all_light_sources();
+
+        int differences = 0;
+        std::optional<point> first_difference;
+        for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                if( lm[x][y].values != lm_incremental->lm[x][y].values ||
+                    sm[x][y] != lm_incremental->sm[x][y] ) {
+                    differences++;
+                    if( !first_difference ) {
+                        first_difference = point( x, y );
+                    }
+                }
+            }
+        }
+        if( first_difference ) {
+            const point &d = *first_difference;
+            debugmsg( "Incremental lightmap differs from full rebuild at %d tiles on z-level %d, first at %s: %s instead of %s",
+                      differences, zlev, d.to_string(), lm_incremental->lm[d.x][d.y].to_string(),
+                      lm[d.x][d.y].to_string() );
         }
+    } else {
+        apply_light_sources_incremental( zlev );
     }
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
@@ -849,14 +898,8 @@ bool map::pl_line_of_sight( const tripoint &t, const int max_range ) const
 //This algorithm is highly inaccurate and only suitable for the low (<60) values use in shadowcasting
 //A starting constant of 21 and 4 iterations matches 2d 60^2. 16 and 5 matches 3d 60^3.
 template <int start, int iterations>
-static inline int fast_rl_dist( tripoint to )
+static constexpr int fast_trig_dist( const int val )
 {
-    if( !trigdist ) {
-        return square_dist( tripoint_zero, to );
-    }
-
-    int val = to.x * to.x + to.y * to.y + to.z * to.z;
-
     if( val < 2 ) {
         return val;
     }
@@ -871,6 +914,61 @@ static inline int fast_rl_dist( tripoint to )
     return a;
 }
 
+template <int start, int iterations>
+static inline int fast_rl_dist( tripoint to )
+{
+    if( !trigdist ) {
+        return square_dist( tripoint_zero, to );
+    }
+
+    return fast_trig_dist<start, iterations>( to.x * to.x + to.y * to.y + to.z * to.z );
+}
+
+// fast_rl_dist<21, 4> for every 2d offset within shadowcasting range.
+// The divisions above dominated the per-tile cost of castLight fast paths.
+struct fast_rl_dist_2d_table {
+    static constexpr int size = 61;
+    std::array<std::array<std::uint8_t, size>, size> values{};
+
+    constexpr fast_rl_dist_2d_table() {
+        for( int x = 0; x < size; x++ ) {
+            for( int y = 0; y < size; y++ ) {
+                values[x][y] = static_cast<std::uint8_t>( fast_trig_dist<21, 4>( x * x + y * y ) );
+            }
+        }
+    }
+};
+
+static constexpr fast_rl_dist_2d_table fast_rl_dist_2d_lookup;
+
+static inline int fast_rl_dist_2d( point to )
+{
+    const int x = std::abs( to.x );
+    const int y = std::abs( to.y );
+    if( !trigdist || x >= fast_rl_dist_2d_table::size || y >= fast_rl_dist_2d_table::size ) {
+        return fast_rl_dist<21, 4>( tripoint( to, 0 ) );
+    }
+
+    return fast_rl_dist_2d_lookup.values[x][y];
+}
+
+// Narrows [lo, hi] so that base + k * x is within [0, size) for every x in it
+template<int k>
+static inline void clip_span( const int base, const int size, int &lo, int &hi )
+{
+    if constexpr( k == 0 ) {
+        if( base < 0 || base >= size ) {
+            hi = lo - 1;
+        }
+    } else if constexpr( k > 0 ) {
+        lo = std::max( lo, -base );
+        hi = std::min( hi, size - 1 - base );
+    } else {
+        lo = std::max( lo, base - ( size - 1 ) );
+        hi = std::min( hi, base );
+    }
+}
+
 // For a direction vector defined by x, y, return the quadrant that's the
 // source of that direction.  Assumes x != 0 && y != 0
 // NOLINTNEXTLINE(cata-xy)
@@ -1257,18 +1355,15 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         //And a limit so that the commented end > trailingEdge is never true
         int x_limit = std::floor( std::min( 0.0f,
                                             ( ( -distance + 0.5f ) * end ) - 0.5f ) ) + 1;
+        // Tiles off the map are skipped without affecting anything, so trim them off
+        // the row once here instead of bounds checking every tile
+        clip_span<xx>( offset.x + delta.y * xy, MAPSIZE_X, delta.x, x_limit );
+        clip_span<yx>( offset.y + delta.y * yy, MAPSIZE_Y, delta.x, x_limit );
 
         int last_dist = -1;
         for( ; delta.x <= x_limit; delta.x++ ) {
             point current( offset.x + delta.x * xx + delta.y * xy, offset.y + delta.x * yx + delta.y * yy );
 
-            if( !( current.x >= 0 && current.y >= 0 && current.x < MAPSIZE_X &&
-                   current.y < MAPSIZE_Y ) /* || start < leadingEdge */ ) {
-                continue;
-            } /*else if( end > trailingEdge ) {
-                break;
-            }*/
-
             if( check_blocked( current ) ) {
                 continue;
             }
@@ -1278,7 +1373,7 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
             }
             if( !eq_nullptr_gcc_hack( lookup ) ) {
                 //Only use fast dist on fast paths, it's slower otherwise. Floating point conversion thing maybe?
-                const int dist = fast_rl_dist<21, 4>( delta ) + offsetDistance;
+                const int dist = fast_rl_dist_2d( delta.xy() ) + offsetDistance;
                 last_intensity = lookup_calc( numerator, lookup->values[dist], dist );
             } else {
                 const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
@@ -1712,6 +1807,53 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
     }
 }
 
+void shared_fov_cache::start_turn( const time_point &now, const tripoint &map_abs_sub )
+{
+    if( turn == now && abs_sub == map_abs_sub ) {
+        return;
+    }
+    turn = now;
+    abs_sub = map_abs_sub;
+    fields_in_use = 0;
+}
+
+bool map::sees_shared( const tripoint &F, const tripoint &T, const int range ) const
+{
+    if( F.z != T.z || !inbounds( F ) || !inbounds( T ) ) {
+        return sees( F, T, range );
+    }
+    if( range >= 0 && range < rl_dist( F, T ) ) {
+        return false;
+    }
+
+    shared_fov_cache &cache = *shared_fovs;
+    cache.start_turn( calendar::turn, abs_sub );
+    shared_fov_cache::field *found = nullptr;
+    for( size_t i = 0; i < cache.fields_in_use; i++ ) {
+        if( cache.fields[i]->origin == T ) {
+            found = cache.fields[i].get();
+            break;
+        }
+    }
+    if( found == nullptr ) {
+        ZoneScopedN( "cast_shared_fov" );
+        if( cache.fields_in_use == cache.fields.size() ) {
+            cache.fields.emplace_back( std::make_unique<shared_fov_cache::field>() );
+        }
+        found = cache.fields[cache.fields_in_use++].get();
+        found->origin = T;
+        const level_cache &map_cache = get_cache_ref( T.z );
+        std::uninitialized_fill_n( &found->seen[0][0], MAPSIZE_X * MAPSIZE_Y,
+                                   static_cast<float>( LIGHT_TRANSPARENCY_SOLID ) );
+        found->seen[T.x][T.y] = VISIBILITY_FULL;
+        castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+        ( found->seen, map_cache.transparency_cache, map_cache.vehicle_obscured_cache, T.xy(), 0 );
+        cache.casts++;
+    }
+    cache.lookups++;
+    return found->seen[F.x][F.y] > LIGHT_TRANSPARENCY_SOLID;
+}
+
 //Schraudolph's algorithm with John's constants
 static inline
 float fastexp( float x )
@@ -1748,28 +1890,25 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
-{
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
+static constexpr int light_north = 1 << 0;
+static constexpr int light_east = 1 << 1;
+static constexpr int light_south = 1 << 2;
+static constexpr int light_west = 1 << 3;
 
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
+// Luminance a light source is cast with, 0 if it only lights its own tile
+static float light_source_cast_luminance( float luminance )
+{
     if( luminance <= lit_level::LOW ) {
-        return;
+        return 0.0f;
     } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
+        return 1.49f;
     }
+    return luminance;
+}
 
+static int light_source_directions( const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                                    const point &p, float luminance )
+{
     /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
          neighboring fires to the north and west that were applied via light_source_buffer
        If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
@@ -1787,12 +1926,28 @@ void map::apply_light_source( const tripoint &p, float luminance )
            sy
     */
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance );
-    bool south = ( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance );
-    bool east = ( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance );
-    bool west = ( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance );
+    int directions = 0;
+    if( p.y != 0 && light_source_buffer[p.x][p.y - 1] < luminance ) {
+        directions |= light_north;
+    }
+    if( p.y != peer_inbounds && light_source_buffer[p.x][p.y + 1] < luminance ) {
+        directions |= light_south;
+    }
+    if( p.x != peer_inbounds && light_source_buffer[p.x + 1][p.y] < luminance ) {
+        directions |= light_east;
+    }
+    if( p.x != 0 && light_source_buffer[p.x - 1][p.y] < luminance ) {
+        directions |= light_west;
+    }
+    return directions;
+}
 
-    if( north ) {
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const point &p2, float luminance, int directions )
+{
+    if( directions & light_north ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1801,7 +1956,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & light_east ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1810,7 +1965,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( directions & light_south ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1819,7 +1974,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & light_west ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1829,6 +1984,203 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
+    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+
+    const point p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
+        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
+    }
+    luminance = light_source_cast_luminance( luminance );
+    if( luminance == 0.0f ) {
+        return;
+    }
+
+    cast_light_source( lm, cache.transparency_cache, cache.vehicle_obscured_cache, p2, luminance,
+                       light_source_directions( cache.light_source_buffer, p2, luminance ) );
+}
+
+// Furthest distance from the source at which cast_light_source can touch the lightmap.
+// Light falls off at least as fast as luminance / distance and casting stops after the first
+// row where it drops to LIGHT_AMBIENT_LOW, the extra tiles cover rounding of the distances.
+static int light_source_reach( float cast_luminance )
+{
+    return std::min( 60, static_cast<int>( cast_luminance / LIGHT_AMBIENT_LOW ) + 3 );
+}
+
+static std::bitset<MAPSIZE *MAPSIZE> changed_transparency( const level_cache &map_cache,
+        const light_source_cache &sources )
+{
+    std::bitset<MAPSIZE *MAPSIZE> changed;
+    for( int smx = 0; smx < MAPSIZE; smx++ ) {
+        for( int smy = 0; smy < MAPSIZE; smy++ ) {
+            const int y = smy * SEEY;
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; x++ ) {
+                if( std::memcmp( &map_cache.transparency_cache[x][y], &sources.transparency_cache[x][y],
+                                 sizeof( float ) * SEEY ) != 0 ||
+                    std::memcmp( &map_cache.vehicle_obscured_cache[x][y], &sources.vehicle_obscured_cache[x][y],
+                                 sizeof( diagonal_blocks ) * SEEY ) != 0 ) {
+                    changed.set( smx * MAPSIZE + smy );
+                    break;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+static bool footprint_changed( const light_source_footprint &source,
+                               const std::bitset<MAPSIZE *MAPSIZE> &changed )
+{
+    // Diagonal blocks are looked up one tile past the lit area
+    const int min_smx = std::max( source.min.x - 1, 0 ) / SEEX;
+    const int min_smy = std::max( source.min.y - 1, 0 ) / SEEY;
+    const int max_smx = std::min( source.max.x + 1, LIGHTMAP_CACHE_X - 1 ) / SEEX;
+    const int max_smy = std::min( source.max.y + 1, LIGHTMAP_CACHE_Y - 1 ) / SEEY;
+    for( int smx = min_smx; smx <= max_smx; smx++ ) {
+        for( int smy = min_smy; smy <= max_smy; smy++ ) {
+            if( changed[smx * MAPSIZE + smy] ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void map::apply_light_sources_incremental( const int zlev )
+{
+    ZoneScoped;
+    level_cache &map_cache = get_cache( zlev );
+    std::unique_ptr<light_source_cache> &cache_ptr = light_source_caches[zlev + OVERMAP_DEPTH];
+    if( !cache_ptr ) {
+        cache_ptr = std::make_unique<light_source_cache>();
+    }
+    light_source_cache &cache = *cache_ptr;
+    const float( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = map_cache.light_source_buffer;
+
+    std::bitset<MAPSIZE *MAPSIZE> changed;
+    if( cache.valid && cache.trigdist == trigdist ) {
+        changed = changed_transparency( map_cache, cache );
+    } else {
+        changed.set();
+    }
+
+    // Sources are cast one at a time into this, it is all zeroes between casts
+    static four_quadrants scratch[MAPSIZE_X][MAPSIZE_Y];
+
+    cache.recast = 0;
+    cache.reused = 0;
+    bool sources_changed = !cache.valid;
+    std::vector<light_source_footprint> sources;
+    auto old_source = cache.sources.begin();
+    for( int x = 0; x < LIGHTMAP_CACHE_X; x++ ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+            const float luminance = light_source_buffer[x][y];
+            if( luminance <= 0.0f ) {
+                continue;
+            }
+            const point p( x, y );
+            const float cast_luminance = light_source_cast_luminance( luminance );
+            const int directions = cast_luminance == 0.0f ? 0 :
+                                   light_source_directions( light_source_buffer, p, cast_luminance );
+
+            // Sources that no longer exist are skipped over
+            while( old_source != cache.sources.end() &&
+                   ( old_source->pos.x < x || ( old_source->pos.x == x && old_source->pos.y < y ) ) ) {
+                sources_changed = true;
+                ++old_source;
+            }
+            if( old_source != cache.sources.end() && old_source->pos == p ) {
+                if( old_source->luminance == luminance && old_source->directions == directions &&
+                    !footprint_changed( *old_source, changed ) ) {
+                    sources.emplace_back( std::move( *old_source ) );
+                    ++old_source;
+                    cache.reused++;
+                    continue;
+                }
+                ++old_source;
+            }
+
+            sources_changed = true;
+            cache.recast++;
+            light_source_footprint &source = sources.emplace_back();
+            source.pos = p;
+            source.luminance = luminance;
+            source.directions = directions;
+            const int reach = cast_luminance == 0.0f ? 0 : light_source_reach( cast_luminance );
+            source.min = point( std::max( x - reach, 0 ), std::max( y - reach, 0 ) );
+            source.max = point( std::min( x + reach, LIGHTMAP_CACHE_X - 1 ),
+                                std::min( y + reach, LIGHTMAP_CACHE_Y - 1 ) );
+
+            // Same as apply_light_source
+            scratch[x][y] = four_quadrants( std::max( static_cast<float>( lit_level::LOW ), luminance ) );
+            if( cast_luminance != 0.0f ) {
+                cast_light_source( scratch, map_cache.transparency_cache, map_cache.vehicle_obscured_cache,
+                                   p, cast_luminance, directions );
+            }
+            source.light.reserve( ( source.max.x - source.min.x + 1 ) * ( source.max.y - source.min.y + 1 ) );
+            for( int lx = source.min.x; lx <= source.max.x; lx++ ) {
+                for( int ly = source.min.y; ly <= source.max.y; ly++ ) {
+                    source.light.emplace_back( scratch[lx][ly] );
+                    scratch[lx][ly] = four_quadrants( 0.0f );
+                }
+            }
+        }
+    }
+    if( old_source != cache.sources.end() ) {
+        sources_changed = true;
+    }
+    cache.sources = std::move( sources );
+
+    if( sources_changed ) {
+        std::fill_n( &cache.combined[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( 0.0f ) );
+        cache.combined_min = point( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y );
+        cache.combined_max = point( -1, -1 );
+        for( const light_source_footprint &source : cache.sources ) {
+            auto light = source.light.begin();
+            for( int x = source.min.x; x <= source.max.x; x++ ) {
+                for( int y = source.min.y; y <= source.max.y; y++ ) {
+                    cache.combined[x][y] = elementwise_max( cache.combined[x][y], *light++ );
+                }
+            }
+            cache.combined_min.x = std::min( cache.combined_min.x, source.min.x );
+            cache.combined_min.y = std::min( cache.combined_min.y, source.min.y );
+            cache.combined_max.x = std::max( cache.combined_max.x, source.max.x );
+            cache.combined_max.y = std::max( cache.combined_max.y, source.max.y );
+        }
+    }
+    if( changed.any() ) {
+        std::memcpy( cache.transparency_cache, map_cache.transparency_cache,
+                     sizeof( cache.transparency_cache ) );
+        std::memcpy( cache.vehicle_obscured_cache, map_cache.vehicle_obscured_cache,
+                     sizeof( cache.vehicle_obscured_cache ) );
+    }
+    cache.valid = true;
+    cache.trigdist = trigdist;
+
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = map_cache.lm;
+    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = map_cache.sm;
+    for( int x = cache.combined_min.x; x <= cache.combined_max.x; x++ ) {
+        for( int y = cache.combined_min.y; y <= cache.combined_max.y; y++ ) {
+            lm[x][y] = elementwise_max( lm[x][y], cache.combined[x][y] );
+        }
+    }
+    for( const light_source_footprint &source : cache.sources ) {
+        sm[source.pos.x][source.pos.y] = std::max( sm[source.pos.x][source.pos.y], source.luminance );
+    }
+}
+
+const light_source_cache *map::get_light_source_cache( const int zlev ) const
+{
+    return inbounds_z( zlev ) ? light_source_caches[zlev + OVERMAP_DEPTH].get() : nullptr;
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
@@ -29,6 +29,18 @@ void loading_ui::add_entry( const std::string &description )
     }
 }
 
+void loading_ui::set_entry_note( const std::string &note )
+{
+    if( menu != nullptr && menu->selected >= 0 &&
+        menu->selected < static_cast<int>( menu->entries.size() ) ) {
+        menu->entries[menu->selected].ctxt = note;
+        if( ui != nullptr ) {
+            // The menu may have to be wider
+            ui->mark_resize();
+        }
+    }
+}
+
 void loading_ui::new_context( const std::string &desc )
 {
     if( menu != nullptr ) {
@@ -29,6 +29,10 @@ class loading_ui
          * Adds a named entry in the current loading context.
          */
         void add_entry( const std::string &description );
+        /**
+         * Sets a short note shown next to the current entry, e.g. how long it took.
+         */
+        void set_entry_note( const std::string &note );
         /**
          * Place the UI onto UI stack, mark current entry as processed, scroll down,
          * and redraw. (if display is enabled)
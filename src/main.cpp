@@ -26,6 +26,7 @@
 #include "color.h"
 #include "crash.h"
 #include "cursesdef.h"
+#include "data_snapshot.h"
 #include "debug.h"
 #include "filesystem.h"
 #include "game.h"
@@ -241,7 +242,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 14> first_pass_arguments = {{
+        const std::array<arg_handler, 15> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -420,6 +421,15 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--rebuild-data-cache", nullptr,
+                    "Loads the game data from the data files even if there's a snapshot of them",
+                    section_default,
+                    []( int, const char ** ) -> int {
+                        rebuild_data_snapshot = true;
+                        return 0;
+                    }
+                },
                 {
                     "--lua-doc", nullptr,
                     "If set, will generate Lua docs and exit",
@@ -90,6 +90,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui_manager.h"
 #include "value_ptr.h"
 #include "veh_type.h"
@@ -193,6 +194,8 @@ map::map( int mapsize, bool zlev )
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    shared_routes = std::make_unique<shared_route_cache>();
+    shared_fovs = std::make_unique<shared_fov_cache>();
 
     dbg( DL::Info ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -479,6 +482,7 @@ void map::on_vehicle_moved( const int smz )
 void map::vehmove()
 {
     ZoneScoped;
+    CATA_TURN_ZONE( "vehmove" );
 
     // give vehicles movement points
     VehicleList vehicle_list;
@@ -1432,6 +1436,7 @@ furn_id map::furn( const tripoint &p ) const
 void map::furn_set( const tripoint &p, const furn_id &new_furniture,
                     const cata::poly_serialized<active_tile_data> &new_active )
 {
+    mark_contents_changed();
     if( !inbounds( p ) ) {
         return;
     }
@@ -1765,6 +1770,7 @@ bool map::is_harvestable( const tripoint &pos ) const
  */
 bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
 {
+    mark_contents_changed();
     if( !inbounds( p ) ) {
         return false;
     }
@@ -2916,6 +2922,7 @@ bool map::has_nearby_chair( const tripoint &p, int radius )
 
 bool map::mop_spills( const tripoint &p )
 {
+    mark_contents_changed();
     bool retval = false;
 
     if( !has_flag( "LIQUIDCONT", p ) && !has_flag( "SEALED", p ) ) {
@@ -3136,6 +3143,7 @@ void map::smash_trap( const tripoint &p, const int power, const std::string &cau
 void map::smash_items( const tripoint &p, const int power, const std::string &cause_message,
                        bool do_destroy )
 {
+    mark_contents_changed();
     if( !has_items( p ) ) {
         return;
     }
@@ -4320,6 +4328,7 @@ map_stack map::i_at( const tripoint &p )
 map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it,
                                 detached_ptr<item>  *out )
 {
+    mark_contents_changed();
     point l;
     submap *const current_submap = get_submap_at( p, l );
 
@@ -4336,6 +4345,7 @@ map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it,
 
 detached_ptr<item> map::i_rem( const tripoint &p, item *it )
 {
+    mark_contents_changed();
     map_stack map_items = i_at( p );
     detached_ptr<item> res;
     map_items.remove_top_items_with( [&res, it]( detached_ptr<item> &&e ) {
@@ -4350,6 +4360,7 @@ detached_ptr<item> map::i_rem( const tripoint &p, item *it )
 
 std::vector<detached_ptr<item>> map::i_clear( const tripoint &p )
 {
+    mark_contents_changed();
     point l;
     submap *const current_submap = get_submap_at( p, l );
 
@@ -4568,6 +4579,7 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
 
 void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
 {
+    mark_contents_changed();
     if( !inbounds( p ) || !new_item ) {
         return;
     }
@@ -4829,6 +4841,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    CATA_TURN_ZONE( "process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -5050,6 +5063,7 @@ std::vector<detached_ptr<item>> use_amount_stack( Stack stack, const itype_id &t
 std::vector<detached_ptr<item>> map::use_amount_square( const tripoint &p, const itype_id &type,
                              int &quantity, const std::function<bool( const item & )> &filter )
 {
+    mark_contents_changed();
     std::vector<detached_ptr<item>> ret;
     // Handle infinite map sources.
     detached_ptr<item> water = water_from( p );
@@ -5182,6 +5196,7 @@ std::vector<detached_ptr<item>> map::use_charges( const tripoint &origin, const
                              const itype_id &type, int &quantity,
                              const std::function<bool( const item & )> &filter )
 {
+    mark_contents_changed();
     std::vector<detached_ptr<item>> ret;
 
     // populate a grid of spots that can be reached
@@ -5677,6 +5692,7 @@ bool map::dangerous_field_at( const tripoint &p )
 bool map::add_field( const tripoint &p, const field_type_id &type_id, int intensity,
                      const time_duration &age, bool hit_player )
 {
+    mark_contents_changed();
     if( !inbounds( p ) ) {
         return false;
     }
@@ -5733,6 +5749,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
 
 void map::remove_field( const tripoint &p, const field_type_id &field_to_remove )
 {
+    mark_contents_changed();
     if( !inbounds( p ) ) {
         return;
     }
@@ -7013,6 +7030,7 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
 
 void map::shift( point sp )
 {
+    mark_contents_changed();
     // Special case of 0-shift; refresh the map
     if( sp == point_zero ) {
         return; // Skip this?
@@ -7239,6 +7257,7 @@ static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
 
 void map::loadn( const tripoint &grid, const bool update_vehicles )
 {
+    mark_contents_changed();
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
@@ -8561,6 +8580,7 @@ void map::do_vehicle_caching( int z )
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     ZoneScoped;
+    CATA_TURN_ZONE( "build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
@@ -9226,6 +9246,7 @@ void map::update_pathfinding_cache( int zlev ) const
     if( !cache.dirty ) {
         return;
     }
+    cache.generation++;
 
     std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
 
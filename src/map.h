@@ -84,8 +84,13 @@ using VehicleList = std::vector<wrapped_vehicle>;
 class map;
 
 enum ter_bitflags : int;
+enum pf_special : int;
 struct pathfinding_cache;
 struct pathfinding_settings;
+struct route_field;
+struct route_step;
+struct shared_route_cache;
+struct shared_route_stats;
 template<typename T>
 struct weighted_int_list;
 struct rl_vec2d;
@@ -357,6 +362,67 @@ struct level_cache {
 
 };
 
+/**
+ * Light cast by a single buffered light source (see @ref map::add_light_source),
+ * kept between lightmap rebuilds.
+ */
+struct light_source_footprint {
+    point pos;
+    float luminance = 0.0f;
+    // Directions the light was cast in, they depend on neighboring buffered sources
+    int directions = 0;
+    // Inclusive bounds of the area the light can reach
+    point min;
+    point max;
+    // Light within the bounds, row by row
+    std::vector<four_quadrants> light;
+};
+
+/**
+ * Buffered light sources of a z-level as of the last lightmap rebuild, along with the
+ * transparency they were cast through.  A source only has to be recast when it changes
+ * or when the transparency within its reach does.
+ */
+struct light_source_cache {
+    bool valid = false;
+    bool trigdist = false;
+    // Ordered by x, then y
+    std::vector<light_source_footprint> sources;
+    // Maximum of the light of all sources, zero outside of the bounds
+    four_quadrants combined[MAPSIZE_X][MAPSIZE_Y];
+    point combined_min;
+    point combined_max;
+    float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks vehicle_obscured_cache[MAPSIZE_X][MAPSIZE_Y];
+    // Number of sources cast and reused during the last rebuild
+    int recast = 0;
+    int reused = 0;
+};
+
+/**
+ * Fields of view cast from the positions of creatures that are looked at a lot, see
+ * map::sees_shared.  Each field is cast once per turn and shared by everyone looking at
+ * its origin.  Like the player's seen cache, they aren't recast when the map changes
+ * during the turn.
+ */
+struct shared_fov_cache {
+    struct field {
+        tripoint origin;
+        float seen[MAPSIZE_X][MAPSIZE_Y];
+    };
+
+    time_point turn = calendar::before_time_starts;
+    tripoint abs_sub;
+    std::vector<std::unique_ptr<field>> fields;
+    // Number of fields in `fields` valid this turn, the rest are kept for reuse
+    size_t fields_in_use = 0;
+    // Visibility checks answered from a field and fields cast, for profiling
+    int lookups = 0;
+    int casts = 0;
+
+    void start_turn( const time_point &now, const tripoint &map_abs_sub );
+};
+
 /**
  * Manage and cache data about a part of the map.
  *
@@ -426,6 +492,17 @@ class map
 
         void set_memory_seen_cache_dirty( const tripoint &p );
 
+        /**
+         * Goes up whenever items, furniture, terrain or fields on the map change, so that what
+         * was gathered from them can be kept until it does.
+         */
+        int get_contents_revision() const {
+            return contents_revision;
+        }
+        void mark_contents_changed() {
+            contents_revision++;
+        }
+
         void invalidate_map_cache( const int zlev );
 
         bool check_seen_cache( const tripoint &p ) const;
@@ -535,7 +612,8 @@ class map
         std::pair<tripoint, maptile> maptile_has_bounds( const tripoint &p, bool bounds_checked );
         std::array<std::pair<tripoint, maptile>, 8> get_neighbors( const tripoint &p );
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                         const time_duration &outdoor_age_speedup, scent_block &sblk );
+                         const time_duration &outdoor_age_speedup, scent_block &sblk,
+                         const oter_id &cur_om_ter );
         void create_hot_air( const tripoint &p, int intensity );
         bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
@@ -610,6 +688,16 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Same as @ref sees, but answered from a field of view cast from `T` by shadowcasting,
+         * which is symmetric, so it's also whether `T` sees `F`.  The field is cast on the first
+         * call in a turn and shared by all the later ones looking at `T`.
+         * Falls back to @ref sees if the points are on different z-levels.
+         */
+        bool sees_shared( const tripoint &F, const tripoint &T, int range ) const;
+        const shared_fov_cache &get_shared_fov_cache() const {
+            return *shared_fovs;
+        }
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -698,6 +786,16 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Same as @ref route, but routes requested towards the same target with the same
+         * settings during one turn are read off a shared distance field instead of each
+         * running A*. Falls back to @ref route whenever the field can't answer the request,
+         * including when there are points to avoid.
+         */
+        std::vector<tripoint> route_shared( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+                                            const std::set<tripoint> &pre_closed = {} ) const;
+        const shared_route_stats &get_shared_route_stats() const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1795,6 +1893,8 @@ class map
         void update_suspension_cache( const int &z );
     protected:
         void generate_lightmap( int zlev );
+        // Applies the light of all buffered light sources, only recasting the ones that changed
+        void apply_light_sources_incremental( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1994,6 +2094,8 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        // Allocated on the first lightmap rebuild of the z-level
+        std::array< std::unique_ptr<light_source_cache>, OVERMAP_LAYERS > light_source_caches;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -2003,6 +2105,7 @@ class map
          * Cache of coordinate pairs recently checked for visibility.
          */
         mutable lru_cache<point, char> skew_vision_cache;
+        mutable std::unique_ptr<shared_fov_cache> shared_fovs;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
@@ -2010,6 +2113,9 @@ class map
         VehicleList last_full_vehicle_list;
         bool last_full_vehicle_list_dirty = true;
 
+        // See get_contents_revision
+        int contents_revision = 0;
+
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
             return *caches[zlev + OVERMAP_DEPTH];
@@ -2017,6 +2123,12 @@ class map
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
 
+        mutable std::unique_ptr<shared_route_cache> shared_routes;
+        // Cost of a single step of the route pathfinder from cur to the adjacent p
+        route_step route_step_cost( const tripoint &cur, const vehicle *cur_veh, const tripoint &p,
+                                    pf_special p_special, const pathfinding_settings &settings ) const;
+        void build_route_field( route_field &field ) const;
+
         visibility_variables visibility_variables_cache;
 
         // caches the highest zlevel above which all zlevels are uniform
@@ -2029,6 +2141,8 @@ class map
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+        // Buffered light sources from the last lightmap rebuild, nullptr if there was none
+        const light_source_cache *get_light_source_cache( int zlev ) const;
 
         void update_pathfinding_cache( int zlev ) const;
 
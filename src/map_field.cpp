@@ -54,6 +54,7 @@
 #include "submap.h"
 #include "teleport.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "units.h"
 #include "vehicle.h"
@@ -143,6 +144,7 @@ int map::burn_body_part( player &u, field_entry &cur, body_part bp_token, const
 void map::process_fields()
 {
     ZoneScoped;
+    CATA_TURN_ZONE( "process_fields" );
 
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
@@ -253,12 +255,9 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p )
 }
 
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                      const time_duration &outdoor_age_speedup, scent_block &sblk )
+                      const time_duration &outdoor_age_speedup, scent_block &sblk,
+                      const oter_id &cur_om_ter )
 {
-    map &here = get_map();
-    // TODO: fix point types
-    const oter_id &cur_om_ter =
-        overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( p ) ) ) );
     const bool sheltered = g->is_sheltered( p );
     const weather_manager &weather = get_weather();
     const int winddirection = weather.winddirection;
@@ -323,7 +322,7 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
     const maptile remove_tile3 = std::get<2>( maptiles );
     if( !spread.empty() && ( !zlevels || one_in( spread.size() ) ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
+        if( sheltered || windpower < 5 ) {
             std::pair<tripoint, maptile> &n = neighs[ random_entry( spread ) ];
             gas_spread_to( cur, n.second, n.first );
         } else {
@@ -416,6 +415,12 @@ void map::process_fields_in_submap( submap *const current_submap,
     int &locy = map_tile.pos_.y;
     const point sm_offset( submap.x * SEEX, submap.y * SEEY );
 
+    // A submap never straddles overmap tiles, so the terrain used for wind calculations
+    // is looked up once here instead of once per spreading gas tile.
+    // TODO: fix point types
+    const oter_id sm_om_ter = overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy(
+                                  here.getabs( tripoint( sm_offset, submap.z ) ) ) ) );
+
     // Loop through all tiles in this submap indicated by current_submap
     for( locx = 0; locx < SEEX; locx++ ) {
         for( locy = 0; locy < SEEY; locy++ ) {
@@ -847,7 +852,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                     const int gas_percent_spread = cur_fd_type.percent_spread;
                     if( gas_percent_spread > 0 ) {
                         const time_duration outdoor_age_speedup = cur_fd_type.outdoor_age_speedup;
-                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk );
+                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk, sm_om_ter );
                     }
                 }
 
@@ -1141,7 +1146,7 @@ void map::process_fields_in_submap( submap *const current_submap,
                                 }
                             }
                         } else {
-                            spread_gas( cur, p, 5, 0_turns, sblk );
+                            spread_gas( cur, p, 5, 0_turns, sblk, sm_om_ter );
                         }
                     }
                 }
@@ -1,13 +1,28 @@
 #include "mapbuffer.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <functional>
-#include <set>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.mutex.h"
+#   include "mingw.condition_variable.h"
+#   include "mingw.thread.h"
+#endif
+
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -18,10 +33,13 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
+#include "profile.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "translations.h"
 #include "ui_manager.h"
 
@@ -30,6 +48,35 @@ static std::string find_quad_path( const std::string &dirname, const tripoint &o
     return string_format( "%s/%d.%d.%d.map", dirname, om_addr.x, om_addr.y, om_addr.z );
 }
 
+// Fix for old saves where the path was generated using std::stringstream, which
+// did format the number using the current locale. That formatting may insert
+// thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+// of "map/1234.7.8.map".
+static std::string find_legacy_quad_path( const std::string &dirname, const tripoint &om_addr )
+{
+    std::ostringstream buffer;
+    buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    return buffer.str();
+}
+
+static std::string find_binary_quad_path( const std::string &dirname, const tripoint &om_addr )
+{
+    return string_format( "%s/%d.%d.%d.bmap", dirname, om_addr.x, om_addr.y, om_addr.z );
+}
+
+static std::string find_palette_path()
+{
+    return g->get_world_base_save_path() + "/maps/ids.json";
+}
+
+// Whether the quad is within the horizontal bounds of a map with the given origin
+static bool is_quad_on_map( const tripoint &om_addr, const tripoint &map_origin )
+{
+    return om_addr.x >= map_origin.x && om_addr.y >= map_origin.y &&
+           om_addr.x <= map_origin.x + HALF_MAPSIZE &&
+           om_addr.y <= map_origin.y + HALF_MAPSIZE;
+}
+
 static std::string find_dirname( const tripoint &om_addr )
 {
     const tripoint segment_addr = omt_to_seg_copy( om_addr );
@@ -37,6 +84,289 @@ static std::string find_dirname( const tripoint &om_addr )
                           segment_addr.y, segment_addr.z );
 }
 
+// Contents of a quad file that is about to be written
+struct quad_write {
+    std::string dirname;
+    // Same as quad_file::path
+    std::string path;
+    std::string target_path;
+    // The quad in the other format, removed once this one is written
+    std::string obsolete_path;
+    bool binary = false;
+    std::string contents;
+};
+
+namespace
+{
+
+struct quad_file {
+    // JSON quad file, also identifies the quad
+    std::string path;
+    std::string legacy_path;
+    std::string binary_path;
+    // Set when the quad file was read, even if it did not exist
+    bool done = false;
+    bool found = false;
+    bool binary = false;
+    std::string contents;
+    std::string error;
+};
+
+// Safe to call from any thread: no debug messages, no game state.
+void read_quad_file( quad_file &file )
+{
+    std::string path = file.binary_path;
+    file.binary = !path.empty() && file_exist( path );
+    if( !file.binary ) {
+        path = file.path;
+    }
+    if( !file_exist( path ) ) {
+        if( !file_exist( file.legacy_path ) ) {
+            file.done = true;
+            return;
+        }
+        path = file.legacy_path;
+    }
+    file.contents = read_entire_file( path );
+    if( file.contents.empty() ) {
+        file.error = string_format( "Failed to read from \"%s\"", path );
+    } else {
+        file.found = true;
+    }
+    file.done = true;
+}
+
+quad_file find_quad_file( const tripoint &om_addr )
+{
+    const std::string dirname = find_dirname( om_addr );
+    quad_file file;
+    file.path = find_quad_path( dirname, om_addr );
+    file.legacy_path = find_legacy_quad_path( dirname, om_addr );
+    file.binary_path = find_binary_quad_path( dirname, om_addr );
+    return file;
+}
+
+} // namespace
+
+/**
+ * Reads and writes quad files on a background thread.
+ * Only file contents are passed between threads, submaps are only ever touched by the main thread.
+ */
+class submap_io_worker
+{
+    public:
+        submap_io_worker() : thread( &submap_io_worker::run, this ) {}
+        ~submap_io_worker() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            work_available.notify_all();
+            thread.join();
+        }
+
+        /** Queue reading the quad file, unless it is already queued or read. */
+        void request_read( const quad_file &file ) {
+            const std::string &path = file.path;
+            std::lock_guard<std::mutex> lock( mutex );
+            if( reads.contains( path ) ) {
+                return;
+            }
+            if( reads.size() >= max_reads ) {
+                // Whatever was read but not used so far was read in vain
+                std::erase_if( reads, []( const auto & it ) {
+                    return it.second.file.done;
+                } );
+            }
+            const std::uint64_t id = next_id++;
+            read_request &request = reads[path];
+            request.id = id;
+            request.file = file;
+            jobs.push_back( { job_type::read, path, id } );
+            work_available.notify_one();
+        }
+
+        /**
+         * Take the result of a requested read, waiting for it if it's not done yet.
+         * @return false if the read was not requested.
+         */
+        bool take_read( const std::string &path, quad_file &file, bool &waited ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            auto it = reads.find( path );
+            if( it == reads.end() ) {
+                return false;
+            }
+            const std::uint64_t id = it->second.id;
+            waited = !it->second.file.done;
+            work_done.wait( lock, [&]() {
+                it = reads.find( path );
+                return it == reads.end() || it->second.id != id || it->second.file.done;
+            } );
+            if( it == reads.end() || it->second.id != id ) {
+                return false;
+            }
+            file = std::move( it->second.file );
+            reads.erase( it );
+            return true;
+        }
+
+        /** Drop the result of a read, the file is about to change. */
+        void forget_read( const std::string &path ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            reads.erase( path );
+        }
+
+        void write( quad_write &&contents ) {
+            const std::string path = contents.path;
+            std::lock_guard<std::mutex> lock( mutex );
+            reads.erase( path );
+            const std::uint64_t id = next_id++;
+            write_request &request = writes[path];
+            request.id = id;
+            request.contents = std::make_shared<const quad_write>( std::move( contents ) );
+            jobs.push_back( { job_type::write, path, id } );
+            work_available.notify_one();
+        }
+
+        /** The file once all queued writes are done, nullptr if there are none. */
+        std::shared_ptr<const quad_write> pending_write( const std::string &path ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            const auto it = writes.find( path );
+            return it == writes.end() ? nullptr : it->second.contents;
+        }
+
+        /** While paused, queued work waits.  Stopping the worker still finishes it. */
+        void set_paused( bool pause ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                paused = pause;
+            }
+            work_available.notify_all();
+        }
+
+        /** Wait for all queued work to finish. */
+        void flush() {
+            std::unique_lock<std::mutex> lock( mutex );
+            work_done.wait( lock, [this]() {
+                return jobs.empty() && !busy;
+            } );
+        }
+
+        /** Wait for queued writes and drop all reads, the world is about to change. */
+        void reset() {
+            flush();
+            std::lock_guard<std::mutex> lock( mutex );
+            reads.clear();
+        }
+
+        std::vector<std::string> take_errors() {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::vector<std::string> result;
+            result.swap( errors );
+            return result;
+        }
+
+    private:
+        enum class job_type : int {
+            read,
+            write,
+        };
+        struct job {
+            job_type type;
+            std::string path;
+            std::uint64_t id;
+        };
+        struct read_request {
+            std::uint64_t id = 0;
+            quad_file file;
+        };
+        struct write_request {
+            std::uint64_t id = 0;
+            std::shared_ptr<const quad_write> contents;
+        };
+
+        // Unused prefetched quads start being discarded past this point
+        static constexpr size_t max_reads = 512;
+
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                work_available.wait( lock, [this]() {
+                    return stopping || ( !paused && !jobs.empty() );
+                } );
+                if( jobs.empty() ) {
+                    // Only stop once everything has been written
+                    return;
+                }
+                const job current = std::move( jobs.front() );
+                jobs.pop_front();
+                busy = true;
+                if( current.type == job_type::read ) {
+                    const auto it = reads.find( current.path );
+                    if( it != reads.end() && it->second.id == current.id ) {
+                        quad_file file;
+                        file.path = it->second.file.path;
+                        file.legacy_path = it->second.file.legacy_path;
+                        file.binary_path = it->second.file.binary_path;
+                        lock.unlock();
+                        read_quad_file( file );
+                        lock.lock();
+                        const auto after = reads.find( current.path );
+                        if( after != reads.end() && after->second.id == current.id ) {
+                            after->second.file = std::move( file );
+                        }
+                    }
+                } else {
+                    // Superseded writes still write the newest contents, so that the id palette
+                    // is always on disk before the quads that were queued after it
+                    const auto it = writes.find( current.path );
+                    if( it != writes.end() ) {
+                        const std::shared_ptr<const quad_write> contents = it->second.contents;
+                        lock.unlock();
+                        const std::string &target = contents->target_path;
+                        const std::string &obsolete = contents->obsolete_path;
+                        std::string error;
+                        try {
+                            assure_dir_exist( contents->dirname );
+                            write_to_file( target, [&]( std::ostream & fout ) {
+                                fout << contents->contents;
+                            } );
+                            if( !obsolete.empty() && file_exist( obsolete ) ) {
+                                remove_file( obsolete );
+                            }
+                        } catch( const std::exception &err ) {
+                            error = string_format( "Failed to write \"%s\": %s", target, err.what() );
+                        }
+                        lock.lock();
+                        if( !error.empty() ) {
+                            errors.emplace_back( std::move( error ) );
+                        }
+                        const auto after = writes.find( current.path );
+                        if( after != writes.end() && after->second.id == current.id ) {
+                            writes.erase( after );
+                        }
+                    }
+                }
+                busy = false;
+                work_done.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable work_done;
+        std::deque<job> jobs;
+        std::map<std::string, read_request> reads;
+        std::map<std::string, write_request> writes;
+        std::vector<std::string> errors;
+        std::uint64_t next_id = 0;
+        bool busy = false;
+        bool paused = false;
+        bool stopping = false;
+        // Last, so that it starts after everything else is initialized
+        std::thread thread;
+};
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
@@ -44,16 +374,96 @@ mapbuffer::~mapbuffer() = default;
 
 void mapbuffer::clear()
 {
+    if( io ) {
+        io->reset();
+        report_io_errors();
+    }
     submaps.clear();
+    // Changes since the last save are discarded along with the submaps
+    unsaved_quads.clear();
+    palette.reset();
 }
 
-bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
+submap_id_palette &mapbuffer::get_palette()
+{
+    if( !palette ) {
+        palette = std::make_unique<submap_id_palette>();
+        // Still in the queue if it was changed by the last save
+        if( const std::shared_ptr<const quad_write> pending = io ? io->pending_write( find_palette_path() ) :
+                nullptr ) {
+            JsonIn jsin( pending->contents, find_palette_path() );
+            palette->deserialize( jsin );
+        } else {
+            read_from_file_optional_json( find_palette_path(), [this]( JsonIn & jsin ) {
+                palette->deserialize( jsin );
+            } );
+        }
+    }
+    return *palette;
+}
+
+submap_io_worker &mapbuffer::get_io()
+{
+    if( !io ) {
+        io = std::make_unique<submap_io_worker>();
+    }
+    return *io;
+}
+
+void mapbuffer::report_io_errors()
+{
+    if( !io ) {
+        return;
+    }
+    for( const std::string &error : io->take_errors() ) {
+        debugmsg( error );
+    }
+}
+
+void mapbuffer::prefetch( const tripoint &p )
 {
     if( submaps.contains( p ) ) {
+        return;
+    }
+    quad_file file = find_quad_file( sm_to_omt_copy( p ) );
+    if( unsaved_quads.contains( file.path ) ) {
+        // Already in memory
+        return;
+    }
+    get_io().request_read( file );
+}
+
+void mapbuffer::set_io_paused( bool paused )
+{
+    get_io().set_paused( paused );
+}
+
+void mapbuffer::flush()
+{
+    if( !io ) {
+        return;
+    }
+    io->flush();
+    std::string failed;
+    for( const std::string &error : io->take_errors() ) {
+        failed += failed.empty() ? error : "\n" + error;
+    }
+    if( !failed.empty() ) {
+        throw std::runtime_error( failed );
+    }
+}
+
+bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
+{
+    if( !submaps.insert( p, sm ) ) {
         return false;
     }
 
-    submaps[p] = std::move( sm );
+    if( io ) {
+        // Whatever was prefetched for this quad is outdated now
+        const tripoint om_addr = sm_to_omt_copy( p );
+        io->forget_read( find_quad_path( find_dirname( om_addr ), om_addr ) );
+    }
 
     return true;
 }
@@ -72,27 +482,22 @@ bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 
 void mapbuffer::remove_submap( tripoint addr )
 {
-    auto m_target = submaps.find( addr );
-    if( m_target == submaps.end() ) {
+    if( !submaps.erase( addr ) ) {
         debugmsg( "Tried to remove non-existing submap %s", addr.to_string() );
-        return;
     }
-    submaps.erase( m_target );
 }
 
 submap *mapbuffer::lookup_submap( const tripoint &p )
 {
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
-        try {
-            return unserialize_submaps( p );
-        } catch( const std::exception &err ) {
-            debugmsg( "Failed to load submap %s: %s", p.to_string(), err.what() );
-        }
-        return nullptr;
+    if( submap *const sm = submaps.find( p ) ) {
+        return sm;
     }
-
-    return iter->second.get();
+    try {
+        return unserialize_submaps( p );
+    } catch( const std::exception &err ) {
+        debugmsg( "Failed to load submap %s: %s", p.to_string(), err.what() );
+    }
+    return nullptr;
 }
 
 void mapbuffer::save( bool delete_after_save )
@@ -108,13 +513,28 @@ void mapbuffer::save( bool delete_after_save )
 
     static_popup popup;
 
-    // A set of already-saved submaps, in global overmap coordinates.
-    std::set<tripoint> saved_submaps;
+    // Quads in global overmap coordinates, sorted so that they are saved in a stable order.
+    std::vector<tripoint> quads;
+    quads.reserve( submaps.size() / 4 + 1 );
+    for( const auto &elem : submaps ) {
+        quads.push_back( sm_to_omt_copy( elem.first ) );
+    }
+    std::sort( quads.begin(), quads.end() );
+    quads.erase( std::unique( quads.begin(), quads.end() ), quads.end() );
+
+    // Quads unloaded since the last save, using ids that may not be written yet
+    write_palette_if_modified();
+    for( auto &unsaved : unsaved_quads ) {
+        get_io().write( std::move( *unsaved.second ) );
+        io_stats.background_writes++;
+    }
+    unsaved_quads.clear();
+
     std::list<tripoint> submaps_to_delete;
     static constexpr std::chrono::milliseconds update_interval( 500 );
     auto last_update = std::chrono::steady_clock::now();
 
-    for( auto &elem : submaps ) {
+    for( const tripoint &om_addr : quads ) {
         auto now = std::chrono::steady_clock::now();
         if( last_update + update_interval < now ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
@@ -124,16 +544,9 @@ void mapbuffer::save( bool delete_after_save )
             inp_mngr.pump_events();
             last_update = now;
         }
-        // Whatever the coordinates of the current submap are,
-        // we're saving a 2x2 quad of submaps at a time.
+        // We're saving a 2x2 quad of submaps at a time.
         // Submaps are generated in quads, so we know if we have one member of a quad,
         // we have the rest of it, if that assumption is broken we have REAL problems.
-        const tripoint om_addr = sm_to_omt_copy( elem.first );
-        if( saved_submaps.contains( om_addr ) ) {
-            // Already handled this one.
-            continue;
-        }
-        saved_submaps.insert( om_addr );
 
         // A segment is a chunk of 32x32 submap quads.
         // We're breaking them into subdirectories so there aren't too many files per directory.
@@ -145,10 +558,7 @@ void mapbuffer::save( bool delete_after_save )
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
         save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+                   delete_after_save || zlev_del || !is_quad_on_map( om_addr, map_origin ) );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
@@ -158,9 +568,52 @@ void mapbuffer::save( bool delete_after_save )
     get_distribution_grid_tracker().on_saved();
 }
 
+void mapbuffer::unload_least_recently_touched( size_t budget )
+{
+    if( budget == 0 || submaps.size() <= budget ) {
+        return;
+    }
+    ZoneScoped;
+
+    const tripoint map_origin = sm_to_omt_copy( get_map().get_abs_sub() );
+    // A quad was touched as recently as its most recently touched submap
+    std::unordered_map<tripoint, time_point> quads;
+    for( const auto &elem : submaps ) {
+        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        if( is_quad_on_map( om_addr, map_origin ) ) {
+            continue;
+        }
+        time_point &touched = quads.try_emplace( om_addr, calendar::before_time_starts ).first->second;
+        touched = std::max( touched, elem.second->last_touched );
+    }
+    std::vector<std::pair<time_point, tripoint>> by_age;
+    by_age.reserve( quads.size() );
+    for( const auto &quad : quads ) {
+        by_age.emplace_back( quad.second, quad.first );
+    }
+    std::sort( by_age.begin(), by_age.end() );
+
+    std::list<tripoint> submaps_to_delete;
+    size_t remaining = submaps.size();
+    for( const auto &quad : by_age ) {
+        if( remaining <= budget ) {
+            break;
+        }
+        const tripoint &om_addr = quad.second;
+        const std::string dirname = find_dirname( om_addr );
+        const size_t deleted_before = submaps_to_delete.size();
+        save_quad( dirname, find_quad_path( dirname, om_addr ), om_addr, submaps_to_delete, true, true );
+        remaining -= submaps_to_delete.size() - deleted_before;
+    }
+    for( const tripoint &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    io_stats.unloaded_submaps += submaps_to_delete.size();
+}
+
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           bool delete_after_save, bool hold_until_save )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -175,7 +628,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr].get();
+        submap *sm = submaps.find( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
@@ -185,7 +638,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
+                if( submaps.contains( submap_addr ) ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -198,22 +651,38 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    std::vector<tripoint> saved_addrs;
+    for( const tripoint &submap_addr : submap_addrs ) {
+        if( submaps.contains( submap_addr ) ) {
+            saved_addrs.push_back( submap_addr );
+        }
+    }
+
+    // Submaps are serialized here, but written to disk in the background.
+    // The directory is only created when writing, so that it's never empty.
+    quad_write quad;
+    quad.dirname = dirname;
+    quad.path = filename;
+    quad.binary = get_option<bool>( "BINARY_MAP_SAVES" );
+    if( quad.binary ) {
+        quad.target_path = find_binary_quad_path( dirname, om_addr );
+        quad.obsolete_path = filename;
+        submap_id_palette &ids = get_palette();
+        write_binary_quad_header( quad.contents, saved_addrs.size() );
+        for( const tripoint &submap_addr : saved_addrs ) {
+            write_binary_submap( quad.contents, submap_addr, *submaps.find( submap_addr ), ids );
+        }
+        if( !hold_until_save ) {
+            // Has to be written before the quads using the new ids
+            write_palette_if_modified();
+        }
+    } else {
+        quad.target_path = filename;
+        quad.obsolete_path = find_binary_quad_path( dirname, om_addr );
+        std::ostringstream fout;
         JsonOut jsout( fout );
         jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( !submaps.contains( submap_addr ) ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr].get();
-
-            if( sm == nullptr ) {
-                continue;
-            }
-
+        for( const tripoint &submap_addr : saved_addrs ) {
             jsout.start_object();
 
             jsout.member( "version", savegame_version );
@@ -225,17 +694,80 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             jsout.write( submap_addr.z );
             jsout.end_array();
 
-            sm->store( jsout );
+            submaps.find( submap_addr )->store( jsout );
 
             jsout.end_object();
-
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
-            }
         }
-
         jsout.end_array();
-    } );
+        quad.contents = fout.str();
+    }
+    if( delete_after_save ) {
+        submaps_to_delete.insert( submaps_to_delete.end(), saved_addrs.begin(), saved_addrs.end() );
+    }
+    if( hold_until_save ) {
+        const std::string path = quad.path;
+        unsaved_quads[path] = std::make_unique<quad_write>( std::move( quad ) );
+        return;
+    }
+    get_io().write( std::move( quad ) );
+    io_stats.background_writes++;
+}
+
+void mapbuffer::write_palette_if_modified()
+{
+    if( !palette || !palette->is_modified() ) {
+        return;
+    }
+    std::ostringstream palette_out;
+    JsonOut jsout( palette_out );
+    palette->serialize( jsout );
+    quad_write palette_file;
+    palette_file.dirname = g->get_world_base_save_path() + "/maps";
+    palette_file.path = find_palette_path();
+    palette_file.target_path = palette_file.path;
+    palette_file.contents = palette_out.str();
+    get_io().write( std::move( palette_file ) );
+}
+
+bool mapbuffer::read_quad( const tripoint &om_addr, std::string &contents, bool &binary )
+{
+    quad_file file = find_quad_file( om_addr );
+
+    report_io_errors();
+    // Unloaded since the last save, the submaps hold the newest state again from now on
+    const auto unsaved = unsaved_quads.find( file.path );
+    if( unsaved != unsaved_quads.end() ) {
+        contents = std::move( unsaved->second->contents );
+        binary = unsaved->second->binary;
+        unsaved_quads.erase( unsaved );
+        return true;
+    }
+    if( io ) {
+        // The quad may have been saved, but not written yet
+        if( const std::shared_ptr<const quad_write> pending = io->pending_write( file.path ) ) {
+            contents = pending->contents;
+            binary = pending->binary;
+            return true;
+        }
+    }
+    bool waited = false;
+    if( io && io->take_read( file.path, file, waited ) ) {
+        if( waited ) {
+            io_stats.prefetch_stalls++;
+        } else {
+            io_stats.prefetch_hits++;
+        }
+    } else {
+        io_stats.direct_reads++;
+        read_quad_file( file );
+    }
+    if( !file.error.empty() ) {
+        debugmsg( file.error );
+        return false;
+    }
+    contents = std::move( file.contents );
+    binary = file.binary;
+    return file.found;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -244,32 +776,31 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
-    const std::string dirname = find_dirname( om_addr );
-    std::string quad_path = find_quad_path( dirname, om_addr );
-
-    if( !file_exist( quad_path ) ) {
-        // Fix for old saves where the path was generated using std::stringstream, which
-        // did format the number using the current locale. That formatting may insert
-        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-        // of "map/1234.7.8.map".
-        std::ostringstream buffer;
-        buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-        if( file_exist( buffer.str() ) ) {
-            quad_path = buffer.str();
-        }
-    }
+    const std::string quad_path = find_quad_path( find_dirname( om_addr ), om_addr );
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+    std::string contents;
+    bool binary = false;
+    if( !read_quad( om_addr, contents, binary ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
-    if( !submaps.contains( p ) ) {
+    try {
+        if( binary ) {
+            deserialize_binary( contents );
+        } else {
+            JsonIn jsin( contents, quad_path );
+            deserialize( jsin );
+        }
+    } catch( const std::exception &err ) {
+        debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path, err.what() );
+        return nullptr;
+    }
+    submap *const sm = submaps.find( p );
+    if( sm == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
                   quad_path, p.x, p.y, p.z );
-        return nullptr;
     }
-    return submaps[ p ].get();
+    return sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
@@ -307,3 +838,17 @@ void mapbuffer::deserialize( JsonIn &jsin )
         }
     }
 }
+
+void mapbuffer::deserialize_binary( std::string_view data )
+{
+    binary_reader in( data );
+    submap_id_palette &ids = get_palette();
+    for( std::uint32_t count = read_binary_quad_header( in ); count > 0; count-- ) {
+        tripoint submap_coordinates;
+        std::unique_ptr<submap> sm = read_binary_submap( in, ids, submap_coordinates );
+        if( !add_submap( submap_coordinates, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
+                      submap_coordinates.z );
+        }
+    }
+}
@@ -2,17 +2,37 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <cstddef>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "coordinates.h"
 #include "point.h"
+#include "submap_store.h"
 
 class submap;
+class submap_id_palette;
+class submap_io_worker;
+struct quad_write;
 class JsonIn;
 
+/** Counters for reading and writing quad files in the background. */
+struct submap_io_stats {
+    // Quads that were read in the background before they were needed
+    int prefetch_hits = 0;
+    // Quads that were needed while their background read was still running
+    int prefetch_stalls = 0;
+    // Quads that were not prefetched and had to be read right away
+    int direct_reads = 0;
+    // Quads handed over to be written in the background
+    int background_writes = 0;
+    // Submaps unloaded to stay within the budget, see @ref mapbuffer::unload_least_recently_touched
+    int unloaded_submaps = 0;
+};
+
 /**
  * Store, buffer, save and load the entire world map.
  */
@@ -28,9 +48,45 @@ class mapbuffer
          **/
         void save( bool delete_after_save = false );
 
-        /** Delete all buffered submaps. **/
+        /** Delete all buffered submaps. Waits for background writes to finish. **/
         void clear();
 
+        /** Start reading the quad containing the given submap in the background,
+         * so that it is ready by the time @ref lookup_submap needs it.
+         * Does nothing if the submap is already loaded.
+         *
+         * @param p The absolute world position in submap coordinates.
+         */
+        void prefetch( const tripoint &p );
+
+        /**
+         * Unload the quads touched the longest time ago until no more than budget submaps are
+         * loaded.  Quads within the reality bubble are never unloaded.  Unloaded quads are kept
+         * serialized in memory and only written by the next @ref save, so that the save files
+         * don't change unless the game is saved.
+         * Pointers to unloaded submaps dangle, so this must only be called when no map but
+         * the main one holds any.
+         * @param budget Maximum number of loaded submaps, 0 for no limit.
+         */
+        void unload_least_recently_touched( size_t budget );
+
+        /**
+         * Hold back reading and writing quad files in the background, e.g. to test reading
+         * quads that were saved but not written yet.  Must be resumed before @ref flush or
+         * @ref clear, which wait for the writes.
+         */
+        void set_io_paused( bool paused );
+
+        /**
+         * Wait for all quads saved by @ref save to be written to disk.
+         * @throws std::runtime_error listing the writes that failed since the last report.
+         */
+        void flush();
+
+        const submap_io_stats &get_io_stats() const {
+            return io_stats;
+        }
+
         /** Add a new submap to the buffer.
          *
          * @param x, y, z The absolute world position in submap coordinates.
@@ -58,16 +114,15 @@ class mapbuffer
             return lookup_submap( p.raw() );
         }
 
-    private:
-        using submap_map_t = std::map<tripoint, std::unique_ptr<submap>>;
-
-    public:
-        submap_map_t::iterator begin() {
+        submap_store::iterator begin() {
             return submaps.begin();
         }
-        submap_map_t::iterator end() {
+        submap_store::iterator end() {
             return submaps.end();
         }
+        size_t size() const {
+            return submaps.size();
+        }
 
         bool is_submap_loaded( const tripoint &p ) const {
             return submaps.contains( p );
@@ -78,11 +133,26 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
+        // Contents of the quad file, from the background thread if possible. False if there is no file.
+        bool read_quad( const tripoint &om_addr, std::string &contents, bool &binary );
+        void deserialize_binary( std::string_view data );
+        // Loaded on first use
+        submap_id_palette &get_palette();
+        submap_io_worker &get_io();
+        void report_io_errors();
         void deserialize( JsonIn &jsin );
+        // Serializes the quad and writes it, or keeps it in unsaved_quads if hold_until_save
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
-        submap_map_t submaps;
+                        bool delete_after_save, bool hold_until_save = false );
+        void write_palette_if_modified();
+        submap_store submaps;
+        // Quads unloaded since the last save, by quad_file::path
+        std::map<std::string, std::unique_ptr<quad_write>> unsaved_quads;
+        // Started on first use
+        std::unique_ptr<submap_io_worker> io;
+        std::unique_ptr<submap_id_palette> palette;
+        submap_io_stats io_stats;
 };
 
 extern mapbuffer MAPBUFFER;
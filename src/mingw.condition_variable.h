@@ -0,0 +1,60 @@
+#pragma once
+/**
+* @file mingw.condition_variable.h
+* @brief std::condition_variable implementation for MinGW without POSIX threads
+*
+* Only what the game uses: waiting on a std::unique_lock<std::mutex> from mingw.mutex.h.
+* Must be included after <condition_variable> and mingw.mutex.h, and before mingw.thread.h.
+*/
+
+#ifndef WIN32STDCONDITIONVARIABLE_H
+#if !defined(_GLIBCXX_HAS_GTHREADS) || defined(WIN32STDTHREAD_H)
+
+#define WIN32STDCONDITIONVARIABLE_H
+
+#include <windows.h>
+#include <condition_variable>
+#include <mutex>
+
+#include "mingw.mutex.h"
+
+namespace std
+{
+
+class condition_variable
+{
+    public:
+        using native_handle_type = PCONDITION_VARIABLE;
+
+        condition_variable() noexcept {
+            InitializeConditionVariable( &mCondition );
+        }
+        condition_variable( const condition_variable & ) = delete;
+        condition_variable &operator=( const condition_variable & ) = delete;
+
+        void notify_one() noexcept {
+            WakeConditionVariable( &mCondition );
+        }
+        void notify_all() noexcept {
+            WakeAllConditionVariable( &mCondition );
+        }
+        void wait( unique_lock<mutex> &lock ) {
+            SleepConditionVariableSRW( &mCondition, lock.mutex()->native_handle(), INFINITE, 0 );
+        }
+        template<class Predicate>
+        void wait( unique_lock<mutex> &lock, Predicate pred ) {
+            while( !pred() ) {
+                wait( lock );
+            }
+        }
+        native_handle_type native_handle() {
+            return &mCondition;
+        }
+
+    private:
+        CONDITION_VARIABLE mCondition;
+};
+
+}
+#endif // _GLIBCXX_HAS_GTHREADS
+#endif // WIN32STDCONDITIONVARIABLE_H
@@ -0,0 +1,51 @@
+#pragma once
+/**
+* @file mingw.mutex.h
+* @brief std::mutex implementation for MinGW without POSIX threads
+*
+* Only what the game uses: a non-recursive mutex on top of a slim reader/writer lock.
+* Must be included after <mutex> and before mingw.thread.h.
+*/
+
+#ifndef WIN32STDMUTEX_H
+#if !defined(_GLIBCXX_HAS_GTHREADS) || defined(WIN32STDTHREAD_H)
+
+#define WIN32STDMUTEX_H
+
+#include <windows.h>
+#include <mutex>
+
+namespace std
+{
+
+class mutex
+{
+    public:
+        using native_handle_type = PSRWLOCK;
+
+        mutex() noexcept {
+            InitializeSRWLock( &mLock );
+        }
+        mutex( const mutex & ) = delete;
+        mutex &operator=( const mutex & ) = delete;
+
+        void lock() {
+            AcquireSRWLockExclusive( &mLock );
+        }
+        bool try_lock() {
+            return TryAcquireSRWLockExclusive( &mLock ) != 0;
+        }
+        void unlock() {
+            ReleaseSRWLockExclusive( &mLock );
+        }
+        native_handle_type native_handle() {
+            return &mLock;
+        }
+
+    private:
+        SRWLOCK mLock;
+};
+
+}
+#endif // _GLIBCXX_HAS_GTHREADS
+#endif // WIN32STDMUTEX_H
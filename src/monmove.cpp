@@ -287,6 +287,13 @@ void monster::wander_to( const tripoint &p, int f )
     wandf = f;
 }
 
+// The faction the tracker files the monster under, see Creature_tracker::add_to_faction_map
+static mfaction_id monster_faction( const monster &mon )
+{
+    static const mfaction_str_id playerfaction( "player" );
+    return mon.friendly == 0 ? mon.faction : playerfaction.id();
+}
+
 float monster::rate_target( Creature &c, float best, bool smart ) const
 {
     const auto d = rl_dist_fast( pos(), c.pos() );
@@ -343,6 +350,11 @@ void monster::plan()
     const int angers_cub_threatened = type->has_anger_trigger( mon_trigger::PLAYER_NEAR_BABY ) ? 8 : 0;
     const int fears_hostile_near = type->has_fear_trigger( mon_trigger::HOSTILE_CLOSE ) ? 5 : 0;
 
+    // Monsters can't see further than this, so anything further away can be neither targeted
+    // nor joined in a swarm
+    const std::vector<monster *> nearby_monsters = g->critter_tracker->find_in_radius( pos(),
+            std::max( max_sight_range, 1 ), std::max( max_sight_range, 1 ) );
+
     bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
@@ -386,7 +398,8 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
+        for( monster *other : nearby_monsters ) {
+            monster &tmp = *other;
             if( tmp.friendly == 0 ) {
                 float rating = rate_target( tmp, dist, smart_planning );
                 if( rating < dist ) {
@@ -451,35 +464,29 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
+        for( monster *other : nearby_monsters ) {
+            monster &mon = *other;
+            auto faction_att = faction.obj().attitude( monster_faction( mon ) );
             if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                 continue;
             }
 
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
                     target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
                 }
             }
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
         }
     }
 
@@ -496,12 +503,11 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
+        for( monster *other : nearby_monsters ) {
+            monster &mon = *other;
+            if( monster_faction( mon ) != actual_faction ) {
                 continue;
             }
-            monster &mon = *shared;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -884,7 +890,7 @@ void monster::move()
             if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
                 ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
                 // We need a new path
-                path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+                path = g->m.route_shared( pos(), goal, pf_settings, get_path_avoid() );
             }
 
             // Try to respect old paths, even if we can't pathfind at the moment
@@ -1392,6 +1392,37 @@ double melee_value( const Character &who, const item &weap );
 /** Evaluate unarmed melee value */
 double unarmed_value( const Character &who );
 
+/** Finds the player's followers that are loaded */
+std::vector<npc *> find_loaded_followers();
+
+/**
+ * What NPCs look at the same way no matter who is looking, gathered once for all of them.
+ * While one exists, NPCs read from it instead of gathering it themselves.
+ */
+class perception_snapshot
+{
+    public:
+        perception_snapshot();
+        ~perception_snapshot();
+        perception_snapshot( const perception_snapshot & ) = delete;
+        perception_snapshot &operator=( const perception_snapshot & ) = delete;
+
+        /** The innermost existing snapshot, or nullptr if there is none */
+        static const perception_snapshot *current();
+
+        /** @ref find_loaded_followers when the snapshot was made */
+        std::vector<npc *> followers;
+        /**
+         * Monsters that were alive when the snapshot was made, the ones NPCs may be hostile to.
+         * Whether they are, and how far away they are, is up to each NPC.  Ones that died since
+         * have to be skipped.
+         */
+        std::vector<weak_ptr_fast<monster>> monsters;
+
+    private:
+        const perception_snapshot *previous;
+};
+
 } // namespace npc_ai
 
 // disable toggled weapon cbms
@@ -458,7 +458,19 @@ void npc::assess_danger()
         }
     }
 
-    for( const monster &critter : g->all_monsters() ) {
+    // Gathered once for all NPCs while there's a snapshot, each NPC judges them for itself
+    std::vector<weak_ptr_fast<monster>> found_monsters;
+    const npc_ai::perception_snapshot *perception = npc_ai::perception_snapshot::current();
+    if( perception == nullptr ) {
+        found_monsters = g->all_monsters().items;
+    }
+    for( const weak_ptr_fast<monster> &critter_ptr : perception ? perception->monsters :
+         found_monsters ) {
+        const shared_ptr_fast<monster> alive = critter_ptr.lock();
+        if( !alive || alive->is_dead() ) {
+            continue;
+        }
+        const monster &critter = *alive;
         auto att = critter.attitude_to( *this );
         if( att == Attitude::A_FRIENDLY ) {
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
@@ -2708,6 +2720,36 @@ void npc::move_away_from( const std::vector<sphere> &spheres, bool no_bashing )
     }
 }
 
+std::vector<npc *> npc_ai::find_loaded_followers()
+{
+    std::vector<npc *> followers;
+    for( const character_id &id : g->get_follower_list() ) {
+        shared_ptr_fast<npc> guy = overmap_buffer.find_npc( id );
+        if( guy ) {
+            followers.push_back( guy.get() );
+        }
+    }
+    return followers;
+}
+
+static const npc_ai::perception_snapshot *current_perception = nullptr;
+
+npc_ai::perception_snapshot::perception_snapshot() : followers( find_loaded_followers() ),
+    monsters( g->all_monsters().items ), previous( current_perception )
+{
+    current_perception = this;
+}
+
+npc_ai::perception_snapshot::~perception_snapshot()
+{
+    current_perception = previous;
+}
+
+const npc_ai::perception_snapshot *npc_ai::perception_snapshot::current()
+{
+    return current_perception;
+}
+
 void npc::see_item_say_smth( const itype_id &object, const std::string &smth )
 {
     map &here = get_map();
@@ -2755,29 +2797,35 @@ void npc::find_item()
         return;
     }
 
+    // Followers are looked up once for all items, and for all NPCs while there's a snapshot
+    std::vector<npc *> found_followers;
+    const npc_ai::perception_snapshot *perception = npc_ai::perception_snapshot::current();
+    if( perception == nullptr ) {
+        found_followers = npc_ai::find_loaded_followers();
+    }
+    const std::vector<npc *> &followers = perception ? perception->followers : found_followers;
+    Character &player_character = get_player_character();
+    const auto seen_by_followers = [&followers]( const tripoint & p ) {
+        return std::any_of( followers.begin(), followers.end(), [&p]( const npc * guy ) {
+            return guy->sees( p );
+        } );
+    };
+    // Whether we're watched doesn't depend on the item
+    const bool watched = !followers.empty() &&
+                         ( player_character.sees( pos() ) || seen_by_followers( pos() ) );
+
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&wanted, &best_value, &followers, &player_character, &seen_by_followers, watched,
+         whitelisting, volume_allowed, weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of( LIQUID ) ) {
             // Don't even consider liquids.
             return;
         }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
-        Character &player_character = get_player_character();
-        for( auto &elem : followers ) {
-            if( !it.is_owned_by( *this, true ) && ( player_character.sees( this->pos() ) ||
-                                                    player_character.sees( wanted_item_pos ) ||
-                                                    elem->sees( this->pos() ) || elem->sees( wanted_item_pos ) ) ) {
-                return;
-            }
+        if( !followers.empty() && !it.is_owned_by( *this, true ) &&
+            ( watched || player_character.sees( wanted_item_pos ) ||
+              seen_by_followers( wanted_item_pos ) ) ) {
+            return;
         }
         if( whitelisting && !item_whitelisted( it ) ) {
             return;
@@ -128,6 +128,27 @@ struct enum_traits<oter_flags> {
     static constexpr auto last = oter_flags::num_oter_flags;
 };
 
+// What an overmap terrain counts as when working out the cost of travelling through it
+enum class omt_travel_class : int {
+    road = 0,
+    field,
+    dirt_road,
+    trail,
+    swamp,
+    water,
+    shore,
+    air,
+    forest,
+    solid, // rock and earth, never passable
+    other,
+    num_omt_travel_classes
+};
+
+template<>
+struct enum_traits<omt_travel_class> {
+    static constexpr auto last = omt_travel_class::num_omt_travel_classes;
+};
+
 struct oter_type_t {
     public:
         static const oter_type_t null_type;
@@ -300,8 +321,20 @@ struct oter_t {
             return type->has_flag( oter_flags::lake_shore );
         }
 
+        omt_travel_class get_travel_class() const {
+            return travel_class;
+        }
+        // Whether travel paths may go up or down from here
+        bool is_travel_ramp() const {
+            return travel_ramp;
+        }
+        // Works out the above, once all terrain has been loaded
+        void finalize_travel();
+
     private:
         om_direction::type dir = om_direction::type::none;
+        omt_travel_class travel_class = omt_travel_class::other;
+        bool travel_ramp = false;
         uint32_t symbol;
         uint32_t symbol_alt;
         size_t line = 0;         // Index of line. Only valid in case of line drawing.
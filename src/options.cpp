@@ -1422,6 +1422,16 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "BINARY_MAP_SAVES", general, translate_marker( "Compact map saves" ),
+         translate_marker( "If true, map data is saved in a compact binary format, which is smaller and faster to save and load than JSON.  Existing map files are converted as they are saved again." ),
+         false
+       );
+
+    add( "LOADED_SUBMAP_LIMIT", general, translate_marker( "Loaded submap limit" ),
+         translate_marker( "Maximum number of submaps kept in memory.  Past it, the ones visited the longest time ago are unloaded, except for those around the player.  Unloaded submaps are kept in a compact form until the game is saved.  0 for no limit." ),
+         0, 1000000, 20000
+       );
+
     add_empty_line();
 
     add( "AUTO_NOTES", general, translate_marker( "Auto notes" ),
@@ -2261,6 +2271,14 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "LIGHTMAP_MODE", debug, translate_marker( "Lightmap rebuild" ),
+         translate_marker( "How light from lamps, fires and other stationary light sources is recalculated each turn.  Incremental: only sources that changed, or whose surroundings changed, are recalculated.  Full: all sources are recalculated.  Compare: both are done and any difference is reported, slow." ),
+    {   { "incremental", translate_marker( "Incremental" ) },
+        { "full", translate_marker( "Full" ) },
+        { "compare", translate_marker( "Compare" ) }
+    },
+    "incremental" );
+
     add( "ENABLE_EVENTS", debug, translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
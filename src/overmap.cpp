@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <cstring>
 #include <exception>
@@ -15,9 +16,14 @@
 #include <optional>
 #include <ostream>
 #include <set>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
 #include "all_enum_values.h"
 #include "assign.h"
 #include "cata_utility.h"
@@ -1003,6 +1009,51 @@ void overmap_terrains::finalize()
     }
 
     set_oter_ids();
+
+    for( const oter_t &elem : terrains.get_all() ) {
+        const_cast<oter_t &>( elem ).finalize_travel(); // Same as above.
+    }
+}
+
+void oter_t::finalize_travel()
+{
+    const oter_id oter = id.id();
+    const auto type_is = [&oter]( const char *name ) {
+        return is_ot_match( name, oter, ot_match_type::type );
+    };
+    const auto prefix_is = [&oter]( const char *name ) {
+        return is_ot_match( name, oter, ot_match_type::prefix );
+    };
+
+    travel_ramp = type_is( "bridgehead_ground" ) || type_is( "bridgehead_ramp" );
+    if( type_is( "road" ) || type_is( "bridge" ) || type_is( "bridge_road" ) ||
+        type_is( "bridgehead_ground" ) || type_is( "bridgehead_ramp" ) ||
+        type_is( "road_nesw_manhole" ) ) {
+        travel_class = omt_travel_class::road;
+    } else if( type_is( "field" ) ) {
+        travel_class = omt_travel_class::field;
+    } else if( prefix_is( "rural_road" ) || prefix_is( "dirt_road" ) || type_is( "subway" ) ||
+               type_is( "lab_subway" ) ) {
+        travel_class = omt_travel_class::dirt_road;
+    } else if( type_is( "forest_trail" ) ) {
+        travel_class = omt_travel_class::trail;
+    } else if( type_is( "forest_water" ) ) {
+        travel_class = omt_travel_class::swamp;
+    } else if( prefix_is( "river" ) || prefix_is( "lake" ) ) {
+        travel_class = type_is( "river_center" ) || type_is( "lake_surface" ) ?
+                       omt_travel_class::water : omt_travel_class::shore;
+    } else if( type_is( "bridge_under" ) ) {
+        travel_class = omt_travel_class::water;
+    } else if( type_is( "open_air" ) ) {
+        travel_class = omt_travel_class::air;
+    } else if( type_is( "forest" ) ) {
+        travel_class = omt_travel_class::forest;
+    } else if( type_is( "empty_rock" ) || type_is( "deep_rock" ) || type_is( "solid_earth" ) ||
+               type_is( "microlab_rock_border" ) ) {
+        travel_class = omt_travel_class::solid;
+    } else {
+        travel_class = omt_travel_class::other;
+    }
 }
 
 void overmap_terrains::reset()
@@ -2948,6 +2999,12 @@ void overmap::init_layers()
     }
 }
 
+static size_t travel_chunk_index( const point_om_omt &p )
+{
+    constexpr int chunks_per_side = OMAPX / overmap::travel_chunk_size;
+    return p.x() / overmap::travel_chunk_size * chunks_per_side + p.y() / overmap::travel_chunk_size;
+}
+
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
 {
     if( !inbounds( p ) ) {
@@ -2955,7 +3012,17 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    oter_id &current = layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
+    std::vector<travel_chunk> &chunks = travel_chunks[p.z() + OVERMAP_DEPTH];
+    const omt_travel_class old_class = current->get_travel_class();
+    const omt_travel_class new_class = id->get_travel_class();
+    if( !chunks.empty() && !is_path( p ) && old_class != new_class ) {
+        travel_chunk &chunk = chunks[travel_chunk_index( p.xy() )];
+        const size_t flags = travel_flags( p );
+        chunk.count( flags, old_class )--;
+        chunk.count( flags, new_class )++;
+    }
+    current = id;
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -2986,13 +3053,21 @@ std::optional<mapgen_arguments> *overmap::mapgen_args( const tripoint_om_omt &p
     return &mapgen_arg_storage[it->second];
 }
 
-bool &overmap::seen( const tripoint_om_omt &p )
+void overmap::set_seen( const tripoint_om_omt &p, bool seen )
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
     }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
+    bool &visible = layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
+    std::vector<travel_chunk> &chunks = travel_chunks[p.z() + OVERMAP_DEPTH];
+    if( !chunks.empty() && visible != seen ) {
+        travel_chunk &chunk = chunks[travel_chunk_index( p.xy() )];
+        const omt_travel_class c = is_path( p ) ? omt_travel_class::road : ter( p )->get_travel_class();
+        const size_t danger = is_marked_dangerous( p ) ? travel_chunk::dangerous : 0;
+        chunk.count( danger | ( visible ? 0 : travel_chunk::unseen ), c )--;
+        chunk.count( danger | ( seen ? 0 : travel_chunk::unseen ), c )++;
+    }
+    visible = seen;
 }
 
 bool overmap::seen( const tripoint_om_omt &p ) const
@@ -3020,13 +3095,22 @@ bool overmap::is_explored( const tripoint_om_omt &p ) const
     return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
 }
 
-bool &overmap::path( const tripoint_om_omt &p )
+void overmap::set_path( const tripoint_om_omt &p, bool path )
 {
     if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    bool &current = layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    std::vector<travel_chunk> &chunks = travel_chunks[p.z() + OVERMAP_DEPTH];
+    if( !chunks.empty() && current != path ) {
+        // Paths count as roads
+        travel_chunk &chunk = chunks[travel_chunk_index( p.xy() )];
+        const omt_travel_class terrain_class = ter( p )->get_travel_class();
+        const size_t flags = travel_flags( p );
+        chunk.count( flags, current ? omt_travel_class::road : terrain_class )--;
+        chunk.count( flags, path ? omt_travel_class::road : terrain_class )++;
+    }
+    current = path;
 }
 
 bool overmap::is_path( const tripoint_om_omt &p ) const
@@ -3037,6 +3121,85 @@ bool overmap::is_path( const tripoint_om_omt &p ) const
     return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
 }
 
+size_t overmap::travel_flags( const tripoint_om_omt &p ) const
+{
+    return ( seen( p ) ? 0 : travel_chunk::unseen ) |
+           ( is_marked_dangerous( p ) ? travel_chunk::dangerous : 0 );
+}
+
+// Terrains within the danger radius of dangerous notes, same as overmap::is_marked_dangerous
+static std::vector<bool> dangerous_terrains( const map_layer &l )
+{
+    std::vector<bool> result( OMAPX * OMAPY, false );
+    for( const om_note &note : l.notes ) {
+        if( !note.dangerous ) {
+            continue;
+        }
+        const int radius = note.danger_radius;
+        for( int x = std::max( note.p.x() - radius, 0 ); x <= std::min( note.p.x() + radius, OMAPX - 1 );
+             x++ ) {
+            for( int y = std::max( note.p.y() - radius, 0 ); y <= std::min( note.p.y() + radius, OMAPY - 1 );
+                 y++ ) {
+                result[x * OMAPY + y] = true;
+            }
+        }
+    }
+    return result;
+}
+
+static void count_travel_chunk( overmap::travel_chunk &chunk, const map_layer &l,
+                                const std::vector<bool> &dangerous, const point_om_omt &corner )
+{
+    chunk = overmap::travel_chunk();
+    for( int x = corner.x(); x < corner.x() + overmap::travel_chunk_size; x++ ) {
+        for( int y = corner.y(); y < corner.y() + overmap::travel_chunk_size; y++ ) {
+            const omt_travel_class c = l.path[x][y] ? omt_travel_class::road :
+                                       l.terrain[x][y]->get_travel_class();
+            const size_t flags = ( l.visible[x][y] ? 0 : overmap::travel_chunk::unseen ) |
+                                 ( dangerous[x * OMAPY + y] ? overmap::travel_chunk::dangerous : 0 );
+            chunk.count( flags, c )++;
+        }
+    }
+}
+
+const overmap::travel_chunk &overmap::travel_chunk_at( const tripoint_om_omt &p ) const
+{
+    std::vector<travel_chunk> &chunks = travel_chunks[p.z() + OVERMAP_DEPTH];
+    if( chunks.empty() ) {
+        chunks.resize( travel_chunk_index( point_om_omt( OMAPX - 1, OMAPY - 1 ) ) + 1 );
+        const map_layer &l = layer[p.z() + OVERMAP_DEPTH];
+        const std::vector<bool> dangerous = dangerous_terrains( l );
+        for( int x = 0; x < OMAPX; x += travel_chunk_size ) {
+            for( int y = 0; y < OMAPY; y += travel_chunk_size ) {
+                const point_om_omt corner( x, y );
+                count_travel_chunk( chunks[travel_chunk_index( corner )], l, dangerous, corner );
+            }
+        }
+    }
+    return chunks[travel_chunk_index( p.xy() )];
+}
+
+void overmap::recount_travel_chunks( const tripoint_om_omt &p, int radius )
+{
+    std::vector<travel_chunk> &chunks = travel_chunks[p.z() + OVERMAP_DEPTH];
+    if( chunks.empty() ) {
+        return;
+    }
+    const map_layer &l = layer[p.z() + OVERMAP_DEPTH];
+    const std::vector<bool> dangerous = dangerous_terrains( l );
+    const auto first_corner = []( int v ) {
+        return std::max( v, 0 ) / travel_chunk_size * travel_chunk_size;
+    };
+    for( int x = first_corner( p.x() - radius ); x <= std::min( p.x() + radius, OMAPX - 1 );
+         x += travel_chunk_size ) {
+        for( int y = first_corner( p.y() - radius ); y <= std::min( p.y() + radius, OMAPY - 1 );
+             y += travel_chunk_size ) {
+            const point_om_omt corner( x, y );
+            count_travel_chunk( chunks[travel_chunk_index( corner )], l, dangerous, corner );
+        }
+    }
+}
+
 bool overmap::mongroup_check( const mongroup &candidate ) const
 {
     const auto matching_range = zg.equal_range( candidate.pos );
@@ -3194,7 +3357,12 @@ void overmap::add_note( const tripoint_om_omt &p, std::string message )
     } else if( !message.empty() ) {
         it->text = std::move( message );
     } else {
+        const bool dangerous = it->dangerous;
+        const int radius = it->danger_radius;
         notes.erase( it );
+        if( dangerous ) {
+            recount_travel_chunks( p, radius );
+        }
     }
 }
 
@@ -3202,8 +3370,10 @@ void overmap::mark_note_dangerous( const tripoint_om_omt &p, int radius, bool is
 {
     for( auto &i : layer[p.z() + OVERMAP_DEPTH].notes ) {
         if( p.xy() == i.p ) {
+            const int old_radius = i.dangerous ? i.danger_radius : 0;
             i.dangerous = is_dangerous;
             i.danger_radius = radius;
+            recount_travel_chunks( p, std::max( old_radius, radius ) );
             return;
         }
     }
@@ -3340,10 +3510,29 @@ void overmap::generate( const overmap *north, const overmap *east,
     connection_cache = overmap_connection_cache{};
     populate_connections_out_from_neighbors( north, east, south, west );
 
+    // The noise doesn't depend on anything placed on the overmap, so unless it was sampled ahead
+    // of time it's sampled on other threads while the rivers are placed
+    const unsigned seed = g->get_seed();
+    std::shared_ptr<const om_noise::om_noise_layers> noise =
+        overmap_buffer.take_prefetched_noise( loc, seed );
+    std::thread noise_thread;
+    if( !noise ) {
+        noise_thread = std::thread( [&noise, seed, base = global_base_point()]() {
+            noise = std::make_shared<const om_noise::om_noise_layers>( base, seed );
+        } );
+    }
+    const auto join_noise_thread = [&noise_thread]() {
+        if( noise_thread.joinable() ) {
+            noise_thread.join();
+        }
+    };
+    on_out_of_scope join_on_error( join_noise_thread );
+
     place_rivers( north, east, south, west );
-    place_lakes();
-    place_forests();
-    place_swamps();
+    join_noise_thread();
+    place_lakes( noise->lake );
+    place_forests( noise->forest );
+    place_swamps( noise->floodplain );
     place_cities();
     place_forest_trails();
     place_roads( north, east, south, west );
@@ -3719,7 +3908,7 @@ void overmap::move_hordes()
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
         if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
-            // TODO: Handle moving to adjacent overmaps.
+            // Hordes walking off the overmap are handed to the next one by overmapbuffer::move_hordes
             if( mg.pos.x() > mg.target.x() ) {
                 mg.pos.x()--;
             }
@@ -3733,15 +3922,16 @@ void overmap::move_hordes()
                 mg.pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
+            // Take the group out at its old location and key it by the new one, without copying it
+            auto node = zg.extract( it++ );
+            node.key() = mg.pos;
+            tmpzg.insert( std::move( node ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    zg.merge( tmpzg );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -3821,8 +4011,11 @@ void overmap::move_hordes()
 void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
     tripoint_om_sm p( p_rel.raw() );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    // Groups are ordered by x first, only the ones within range of it need to be looked at
+    const auto first = zg.lower_bound( tripoint_om_sm( p.x() - sig_power, INT_MIN, INT_MIN ) );
+    const auto last = zg.upper_bound( tripoint_om_sm( p.x() + sig_power, INT_MAX, INT_MAX ) );
+    for( auto it = first; it != last; ++it ) {
+        mongroup &mg = it->second;
         if( !mg.horde ) {
             continue;
         }
@@ -4077,14 +4270,12 @@ void overmap::place_forest_trailheads()
     }
 }
 
-void overmap::place_forests()
+void overmap::place_forests( const om_noise::om_noise_layer &f )
 {
     const oter_id default_oter_id( settings->default_oter );
     const oter_id forest( "forest" );
     const oter_id forest_thick( "forest_thick" );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
-
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint_om_omt p( x, y, 0 );
@@ -4108,10 +4299,8 @@ void overmap::place_forests()
     }
 }
 
-void overmap::place_lakes()
+void overmap::place_lakes( const om_noise::om_noise_layer &f )
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
-
     const auto is_lake = [&]( const point_om_omt & p ) {
         return f.noise_at( p ) > settings->overmap_lake.noise_threshold_lake;
     };
@@ -4404,7 +4593,7 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     }
 }
 
-void overmap::place_swamps()
+void overmap::place_swamps( const om_noise::om_noise_layer &f )
 {
     // Buffer our river terrains by a variable radius and increment a counter for the location each
     // time it's included in a buffer. It's a floodplain that we'll then intersect later with some
@@ -4430,9 +4619,7 @@ void overmap::place_swamps()
 
     const oter_id forest_water( "forest_water" );
 
-    // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
-
+    // Intersect the river buffered floodplain with the floodplain noise layer.
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             const tripoint_om_omt pos( x, y, 0 );
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -47,6 +48,11 @@ struct regional_settings;
 struct specials_overlay;
 template <typename E> struct enum_traits;
 
+namespace om_noise
+{
+class om_noise_layer;
+} // namespace om_noise
+
 namespace pf
 {
 template<typename Point>
@@ -233,13 +239,40 @@ class overmap
         const oter_id &ter( const tripoint_om_omt &p ) const;
         std::string *join_used_at( const om_pos_dir & );
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_om_omt & );
-        bool &seen( const tripoint_om_omt &p );
+        void set_seen( const tripoint_om_omt &p, bool seen );
         bool seen( const tripoint_om_omt &p ) const;
         bool &explored( const tripoint_om_omt &p );
         bool is_explored( const tripoint_om_omt &p ) const;
-        bool &path( const tripoint_om_omt &p );
+        void set_path( const tripoint_om_omt &p, bool path );
         bool is_path( const tripoint_om_omt &p ) const;
 
+        // Side of the square chunks that long travel paths are first found across
+        static constexpr int travel_chunk_size = 20;
+        static_assert( OMAPX % travel_chunk_size == 0, "chunks must tile the overmap" );
+        /**
+         * How many overmap terrains of each travel class a chunk has, counted separately
+         * for terrains the player hasn't seen and terrains marked as dangerous.
+         */
+        struct travel_chunk {
+            static constexpr size_t unseen = 1;
+            static constexpr size_t dangerous = 2;
+            // Indexed by the above flags, then by travel class
+            std::array<std::array<std::uint16_t,
+                static_cast<size_t>( omt_travel_class::num_omt_travel_classes )>, 4> counts{};
+
+            std::uint16_t &count( size_t flags, omt_travel_class c ) {
+                return counts[flags][static_cast<size_t>( c )];
+            }
+            std::uint16_t count( size_t flags, omt_travel_class c ) const {
+                return counts[flags][static_cast<size_t>( c )];
+            }
+        };
+        /**
+         * The chunk that @p p is in.  Worked out when first asked for, and kept up to date
+         * by @ref ter_set, @ref set_seen, @ref set_path and changes to dangerous notes.
+         */
+        const travel_chunk &travel_chunk_at( const tripoint_om_omt &p ) const;
+
         bool has_note( const tripoint_om_omt &p ) const;
         std::optional<int> has_note_with_danger_radius( const tripoint_om_omt &p ) const;
         bool is_marked_dangerous( const tripoint_om_omt &p ) const;
@@ -306,6 +339,7 @@ class overmap
             return *settings;
         }
 
+        void add_mon_group( const mongroup &group );
         void clear_mon_groups();
         void clear_overmap_special_placements();
         void clear_cities();
@@ -360,6 +394,12 @@ class overmap
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
+        // Empty until asked for, see travel_chunk_at
+        mutable std::array<std::vector<travel_chunk>, OVERMAP_LAYERS> travel_chunks;
+        // Which of the travel_chunk flags apply to the terrain at p
+        size_t travel_flags( const tripoint_om_omt &p ) const;
+        // Counts the terrains of the chunks that overlap the square again, if they're counted
+        void recount_travel_chunks( const tripoint_om_omt &p, int radius );
 
         // Records the locations where a given overmap special was placed, which
         // can be used after placement to lookup whether a given location was created
@@ -417,11 +457,11 @@ class overmap
 
         // Overall terrain
         void place_river( point_om_omt pa, point_om_omt pb );
-        void place_forests();
-        void place_lakes();
+        void place_forests( const om_noise::om_noise_layer &f );
+        void place_lakes( const om_noise::om_noise_layer &f );
         void place_rivers( const overmap *north, const overmap *east, const overmap *south,
                            const overmap *west );
-        void place_swamps();
+        void place_swamps( const om_noise::om_noise_layer &f );
         void place_forest_trails();
         void place_forest_trailheads();
 
@@ -502,8 +542,6 @@ class overmap
         void place_mongroups();
         void place_radios();
 
-        void add_mon_group( const mongroup &group );
-
         void load_monster_groups( JsonIn &jsin );
         void load_legacy_monstergroups( JsonIn &jsin );
         void save_monster_groups( JsonOut &jo ) const;
@@ -1,5 +1,10 @@
 #include <cmath>
 #include <algorithm>
+#include <thread>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#include "mingw.thread.h"
+#endif
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
@@ -35,4 +40,19 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+om_noise_layers::om_noise_layers( const point_abs_omt &global_base_point, unsigned seed ) :
+    seed( seed ), forest( global_base_point, seed ), floodplain( global_base_point, seed ),
+    lake( global_base_point, seed )
+{
+    std::thread forest_thread( [this]() {
+        forest.sample();
+    } );
+    std::thread floodplain_thread( [this]() {
+        floodplain.sample();
+    } );
+    lake.sample();
+    forest_thread.join();
+    floodplain_thread.join();
+}
+
 } // namespace om_noise
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 #include "point.h"
@@ -78,6 +80,51 @@ class om_noise_layer_lake : public om_noise_layer
         float noise_at( const point_om_omt &local_omt_pos ) const override;
 };
 
+/**
+ * A layer with its values at every point of one overmap worked out up front by @ref sample.
+ * Points outside of the overmap, and all points before sampling, are passed on to the layer.
+ */
+template<typename Layer>
+class om_noise_layer_sampled : public Layer
+{
+    public:
+        using Layer::Layer;
+
+        void sample() {
+            values.resize( OMAPX * OMAPY );
+            for( int x = 0; x < OMAPX; x++ ) {
+                for( int y = 0; y < OMAPY; y++ ) {
+                    values[x * OMAPY + y] = Layer::noise_at( point_om_omt( x, y ) );
+                }
+            }
+        }
+
+        float noise_at( const point_om_omt &local_omt_pos ) const override {
+            if( values.empty() || local_omt_pos.x() < 0 || local_omt_pos.x() >= OMAPX ||
+                local_omt_pos.y() < 0 || local_omt_pos.y() >= OMAPY ) {
+                return Layer::noise_at( local_omt_pos );
+            }
+            return values[local_omt_pos.x() * OMAPY + local_omt_pos.y()];
+        }
+
+    private:
+        std::vector<float> values;
+};
+
+/**
+ * All the layers used to generate one overmap, sampled on construction.  They don't depend on
+ * each other or on what's already placed on the overmap, so they're sampled in parallel, and
+ * can be sampled ahead of generating the overmap on another thread.
+ */
+struct om_noise_layers {
+    om_noise_layers( const point_abs_omt &global_base_point, unsigned seed );
+
+    unsigned seed;
+    om_noise_layer_sampled<om_noise_layer_forest> forest;
+    om_noise_layer_sampled<om_noise_layer_floodplain> floodplain;
+    om_noise_layer_sampled<om_noise_layer_lake> lake;
+};
+
 } // namespace om_noise
 
 #endif // CATA_SRC_OVERMAP_NOISE_H
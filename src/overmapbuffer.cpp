@@ -3,11 +3,23 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <queue>
+#include <thread>
+#include <unordered_set>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.mutex.h"
+#   include "mingw.condition_variable.h"
+#   include "mingw.thread.h"
+#endif
 
 #include "avatar.h"
 #include "calendar.h"
@@ -32,6 +44,7 @@
 #include "npc.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_noise.h"
 #include "overmap_special.h"
 #include "overmap_types.h"
 #include "popup.h"
@@ -49,11 +62,122 @@ class map_extra;
 
 overmapbuffer overmap_buffer;
 
+/**
+ * Samples the noise layers of overmaps that are likely to be generated soon on a worker thread.
+ * Only the noise is worked out ahead of time: it depends on nothing but the position and the
+ * seed, so the overmaps come out the same no matter when or where it was sampled.
+ */
+class overmap_noise_prefetcher
+{
+    public:
+        ~overmap_noise_prefetcher() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            work_available.notify_all();
+            thread.join();
+        }
+
+        // Forgets whatever isn't in @p wanted, and queues what's missing from it
+        void request( const std::vector<point_abs_om> &wanted, unsigned seed ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::erase_if( entries, [&]( const std::pair<const point_abs_om, entry> &e ) {
+                return e.second.seed != seed ||
+                       std::find( wanted.begin(), wanted.end(), e.first ) == wanted.end();
+            } );
+            pending.clear();
+            for( const point_abs_om &p : wanted ) {
+                if( entries.emplace( p, entry{ seed, false, nullptr } ).second ) {
+                    pending.push_back( p );
+                }
+            }
+            work_available.notify_all();
+        }
+
+        std::shared_ptr<const om_noise::om_noise_layers> take( const point_abs_om &p, unsigned seed ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            const auto it = entries.find( p );
+            if( it == entries.end() || it->second.seed != seed ) {
+                return nullptr;
+            }
+            if( !it->second.started ) {
+                // Sampling it right away is no slower than waiting for it
+                entries.erase( it );
+                std::erase( pending, p );
+                return nullptr;
+            }
+            sampled.wait( lock, [&]() {
+                return entries.at( p ).layers != nullptr;
+            } );
+            const auto found = entries.find( p );
+            std::shared_ptr<const om_noise::om_noise_layers> result = std::move( found->second.layers );
+            entries.erase( found );
+            return result;
+        }
+
+        // Waits until everything requested so far is sampled
+        void wait() {
+            std::unique_lock<std::mutex> lock( mutex );
+            sampled.wait( lock, [this]() {
+                return pending.empty() && std::all_of( entries.begin(), entries.end(),
+                []( const std::pair<const point_abs_om, entry> &e ) {
+                    return e.second.layers != nullptr;
+                } );
+            } );
+        }
+
+    private:
+        struct entry {
+            unsigned seed = 0;
+            bool started = false;
+            std::shared_ptr<const om_noise::om_noise_layers> layers;
+        };
+
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                work_available.wait( lock, [this]() {
+                    return stopping || !pending.empty();
+                } );
+                if( stopping ) {
+                    return;
+                }
+                const point_abs_om p = pending.front();
+                pending.pop_front();
+                entry &e = entries.at( p );
+                e.started = true;
+                const unsigned seed = e.seed;
+                lock.unlock();
+                std::shared_ptr<const om_noise::om_noise_layers> layers =
+                    std::make_shared<const om_noise::om_noise_layers>( project_to<coords::omt>( p ), seed );
+                lock.lock();
+                // Might have been forgotten in the meantime
+                const auto it = entries.find( p );
+                if( it != entries.end() && it->second.seed == seed ) {
+                    it->second.layers = std::move( layers );
+                }
+                sampled.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable sampled;
+        std::map<point_abs_om, entry> entries;
+        std::deque<point_abs_om> pending;
+        bool stopping = false;
+        // Last, so that it starts after everything else is initialized
+        std::thread thread{ &overmap_noise_prefetcher::run, this };
+};
+
 overmapbuffer::overmapbuffer()
     : last_requested_overmap( nullptr )
 {
 }
 
+overmapbuffer::~overmapbuffer() = default;
+
 const city_reference city_reference::invalid{ nullptr, tripoint_abs_sm(), -1 };
 
 int city_reference::get_distance_from_bounds() const
@@ -138,9 +262,18 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
             continue;
         }
         overmap &om = get( omp );
+        // The target is relative to the overmap as well, it stays where it was
+        mg.target += sm_rem.raw() - mg.pos.xy().raw();
         mg.pos = tripoint_om_sm( sm_rem, mg.pos.z() );
-        om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        if( mg.radius == 1 ) {
+            // Hand the group over as it is, without copying its monsters
+            auto node = new_overmap.zg.extract( it++ );
+            node.key() = mg.pos;
+            om.zg.insert( std::move( node ) );
+        } else {
+            om.add_mon_group( mg );
+            new_overmap.zg.erase( it++ );
+        }
     }
 }
 
@@ -209,6 +342,46 @@ void overmapbuffer::clear()
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
+    noise_prefetcher.reset();
+    last_prefetch_center.reset();
+}
+
+void overmapbuffer::prefetch_around( const point_abs_om &center )
+{
+    if( last_prefetch_center == center ) {
+        return;
+    }
+    last_prefetch_center = center;
+    std::vector<point_abs_om> wanted;
+    for( const point_abs_om &p : closest_points_first( center, 1 ) ) {
+        if( overmaps.contains( p ) ) {
+            continue;
+        }
+        if( !known_non_existing.contains( p ) ) {
+            if( file_exist( terrain_filename( p ) ) ) {
+                continue;
+            }
+            known_non_existing.insert( p );
+        }
+        wanted.push_back( p );
+    }
+    if( !noise_prefetcher ) {
+        noise_prefetcher = std::make_unique<overmap_noise_prefetcher>();
+    }
+    noise_prefetcher->request( wanted, g->get_seed() );
+}
+
+void overmapbuffer::wait_for_prefetched_noise()
+{
+    if( noise_prefetcher ) {
+        noise_prefetcher->wait();
+    }
+}
+
+std::shared_ptr<const om_noise::om_noise_layers> overmapbuffer::take_prefetched_noise(
+    const point_abs_om &p, unsigned seed )
+{
+    return noise_prefetcher ? noise_prefetcher->take( p, seed ) : nullptr;
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -409,7 +582,7 @@ bool overmapbuffer::is_path( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_path( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->path( om_loc.local ) = !om_loc.om->path( om_loc.local );
+    om_loc.om->set_path( om_loc.local, !om_loc.om->is_path( om_loc.local ) );
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -513,9 +686,14 @@ void overmapbuffer::move_hordes()
     const auto radius = MAPSIZE * 2;
     // TODO: fix point types
     const tripoint_abs_sm center( get_player_character().global_sm_location() );
-    for( auto &om : get_overmaps_near( center, radius ) ) {
+    const std::vector<overmap *> nearby = get_overmaps_near( center, radius );
+    for( overmap *om : nearby ) {
         om->move_hordes();
     }
+    // Only once all have moved, so hordes don't move again on the overmap they walked onto
+    for( overmap *om : nearby ) {
+        fix_mongroups( *om );
+    }
 }
 
 std::vector<mongroup *> overmapbuffer::monsters_at( const tripoint_abs_omt &p )
@@ -638,7 +816,7 @@ bool overmapbuffer::seen( const tripoint_abs_omt &p )
 void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->seen( om_loc.local ) = seen;
+    om_loc.om->set_seen( om_loc.local, seen );
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -769,63 +947,213 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params )
+static int travel_class_cost( omt_travel_class travel_class, const overmap_path_params &params )
+{
+    switch( travel_class ) {
+        case omt_travel_class::road:
+            return params.road_cost;
+        case omt_travel_class::field:
+            return params.field_cost;
+        case omt_travel_class::dirt_road:
+            return params.dirt_road_cost;
+        case omt_travel_class::trail:
+            return params.trail_cost;
+        case omt_travel_class::swamp:
+            return params.swamp_cost;
+        case omt_travel_class::water:
+            return params.water_cost;
+        case omt_travel_class::shore:
+            return params.shore_cost;
+        case omt_travel_class::air:
+            return params.air_cost;
+        case omt_travel_class::forest:
+            return params.forest_cost;
+        case omt_travel_class::solid:
+            return -1;
+        case omt_travel_class::other:
+        case omt_travel_class::num_omt_travel_classes:
+            break;
+    }
+    return params.other_cost;
+}
+
+// Terrain of overmaps that don't exist yet
+static const oter_id ot_null;
+
+static int get_terrain_cost( const overmap *om, const tripoint_om_omt &p,
+                             const overmap_path_params &params )
 {
-    if( params.only_known_by_player && !overmap_buffer.seen( omt_pos ) ) {
+    if( params.only_known_by_player && ( !om || !om->seen( p ) ) ) {
         return -1;
     }
-    if( params.avoid_danger && overmap_buffer.is_marked_dangerous( omt_pos ) ) {
+    if( params.avoid_danger && om && om->is_marked_dangerous( p ) ) {
         return -1;
     }
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
-    if( is_ot_match( "road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge_road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ramp", oter, ot_match_type::type ) ||
-        is_ot_match( "road_nesw_manhole", oter, ot_match_type::type ) ||
-        overmap_buffer.is_path( omt_pos ) ) {
+    if( om && om->is_path( p ) ) {
         return params.road_cost;
-    } else if( is_ot_match( "field", oter, ot_match_type::type ) ) {
-        return params.field_cost;
-    } else if( is_ot_match( "rural_road", oter, ot_match_type::prefix ) ||
-               is_ot_match( "dirt_road", oter, ot_match_type::prefix ) ||
-               is_ot_match( "subway", oter, ot_match_type::type ) ||
-               is_ot_match( "lab_subway", oter, ot_match_type::type ) ) {
-        return params.dirt_road_cost;
-    } else if( is_ot_match( "forest_trail", oter, ot_match_type::type ) ) {
-        return params.trail_cost;
-    } else if( is_ot_match( "forest_water", oter, ot_match_type::type ) ) {
-        return params.swamp_cost;
-    } else if( is_ot_match( "river", oter, ot_match_type::prefix ) ||
-               is_ot_match( "lake", oter, ot_match_type::prefix ) ) {
-        if( is_ot_match( "river_center", oter, ot_match_type::type ) ||
-            is_ot_match( "lake_surface", oter, ot_match_type::type ) ) {
-            return params.water_cost;
-        } else {
-            return params.shore_cost;
+    }
+    return travel_class_cost( ( om ? om->ter( p ) : ot_null )->get_travel_class(), params );
+}
+
+// Radius of the search for travel paths in overmap terrains, 4 overmaps
+static constexpr int travel_path_radius = 4 * OMAPX;
+
+static point travel_chunk_of( const point_abs_omt &p )
+{
+    return divide_xy_round_to_minus_infinity( p.raw(), overmap::travel_chunk_size );
+}
+
+/**
+ * Cost of crossing a chunk of @ref overmap::travel_chunk_size terrains, or -1 if none of it
+ * can be crossed.  Chunks that are partly impassable cost more, they're likely to need a detour.
+ * Same as @ref get_terrain_cost, unseen and dangerous terrains may be impassable.
+ */
+static int travel_chunk_cost( const overmap::travel_chunk &chunk, const overmap_path_params &params )
+{
+    std::int64_t passable = 0;
+    std::int64_t total_cost = 0;
+    for( size_t flags = 0; flags < chunk.counts.size(); flags++ ) {
+        if( ( params.only_known_by_player && ( flags & overmap::travel_chunk::unseen ) ) ||
+            ( params.avoid_danger && ( flags & overmap::travel_chunk::dangerous ) ) ) {
+            continue;
         }
-    } else if( is_ot_match( "bridge_under", oter, ot_match_type::type ) ) {
-        return params.water_cost;
-    } else if( is_ot_match( "open_air", oter, ot_match_type::type ) ) {
-        return params.air_cost;
-    } else if( is_ot_match( "forest", oter, ot_match_type::type ) ) {
-        return params.forest_cost;
-    } else if( is_ot_match( "empty_rock", oter, ot_match_type::type ) ||
-               is_ot_match( "deep_rock", oter, ot_match_type::type ) ||
-               is_ot_match( "solid_earth", oter, ot_match_type::type ) ||
-               is_ot_match( "microlab_rock_border", oter, ot_match_type::type ) ) {
+        for( size_t i = 0; i < chunk.counts[flags].size(); i++ ) {
+            const int cost = travel_class_cost( static_cast<omt_travel_class>( i ), params );
+            const std::uint16_t count = chunk.counts[flags][i];
+            if( cost >= 0 ) {
+                passable += count;
+                total_cost += static_cast<std::int64_t>( cost ) * count;
+            }
+        }
+    }
+    if( passable == 0 ) {
         return -1;
-    } else {
-        return params.other_cost;
     }
+    constexpr std::int64_t area = overmap::travel_chunk_size * overmap::travel_chunk_size;
+    return total_cost * overmap::travel_chunk_size * area / ( passable * passable );
+}
+
+std::unordered_set<point> overmapbuffer::find_travel_corridor( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, int radius, const overmap_path_params &params )
+{
+    constexpr int size = overmap::travel_chunk_size;
+    const point src_chunk = travel_chunk_of( src.xy() );
+    const point dest_chunk = travel_chunk_of( dest.xy() );
+    const int chunk_radius = radius / size + 1;
+    const int side = chunk_radius * 2 + 1;
+    const point origin = src_chunk - point( chunk_radius, chunk_radius );
+    const auto index_of = [&]( const point & c ) {
+        return ( c.x - origin.x ) * side + ( c.y - origin.y );
+    };
+    const auto inbounds = [&]( const point & c ) {
+        return c.x >= origin.x && c.x < origin.x + side && c.y >= origin.y && c.y < origin.y + side;
+    };
+    if( !inbounds( dest_chunk ) ) {
+        return {};
+    }
+
+    // A chunk that's in no existing overmap, the player can't have seen it either
+    overmap::travel_chunk unknown_chunk;
+    unknown_chunk.count( overmap::travel_chunk::unseen, ot_null->get_travel_class() ) = size * size;
+    std::vector<int> chunk_costs( side * side, -2 );
+    const auto chunk_cost = [&]( const point & c ) {
+        int &cost = chunk_costs[index_of( c )];
+        if( cost == -2 ) {
+            const tripoint_abs_omt corner( tripoint( c * size, src.z() ) );
+            const overmap_with_local_coords om_loc = get_existing_om_global( corner );
+            cost = travel_chunk_cost( om_loc ? om_loc.om->travel_chunk_at( om_loc.local ) : unknown_chunk,
+                                      params );
+        }
+        return cost;
+    };
+
+    // Plain A* over the chunks, estimating the rest of the way at the cheapest terrain
+    int cheapest = INT_MAX;
+    for( size_t i = 0; i < static_cast<size_t>( omt_travel_class::num_omt_travel_classes ); i++ ) {
+        const int cost = travel_class_cost( static_cast<omt_travel_class>( i ), params );
+        if( cost >= 0 ) {
+            cheapest = std::min( cheapest, cost );
+        }
+    }
+    if( cheapest == INT_MAX ) {
+        return {};
+    }
+    std::vector<int> best( side * side, INT_MAX );
+    std::vector<point> came_from( side * side );
+    using scored_chunk = std::pair<int, point>;
+    std::priority_queue<scored_chunk, std::vector<scored_chunk>, std::greater<>> open;
+    best[index_of( src_chunk )] = 0;
+    open.emplace( 0, src_chunk );
+    bool found = false;
+    while( !open.empty() ) {
+        const point cur = open.top().second;
+        open.pop();
+        if( cur == dest_chunk ) {
+            found = true;
+            break;
+        }
+        for( const point &d : four_adjacent_offsets ) {
+            const point next = cur + d;
+            if( !inbounds( next ) ) {
+                continue;
+            }
+            const int cost = next == dest_chunk ? std::max( chunk_cost( next ), 0 ) : chunk_cost( next );
+            if( cost < 0 ) {
+                continue;
+            }
+            const int total = best[index_of( cur )] + cost;
+            if( total < best[index_of( next )] ) {
+                best[index_of( next )] = total;
+                came_from[index_of( next )] = cur;
+                open.emplace( total + manhattan_dist( next, dest_chunk ) * size * cheapest, next );
+            }
+        }
+    }
+    if( !found ) {
+        return {};
+    }
+
+    // The chunks on the path and all around them, so that the detailed search has room to move
+    std::unordered_set<point> corridor;
+    for( point c = dest_chunk; ; c = came_from[index_of( c )] ) {
+        for( int x = -1; x <= 1; x++ ) {
+            for( int y = -1; y <= 1; y++ ) {
+                corridor.insert( c + point( x, y ) );
+            }
+        }
+        if( c == src_chunk ) {
+            break;
+        }
+    }
+    return corridor;
 }
 
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
+std::vector<tripoint_abs_omt> overmapbuffer::find_travel_path( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, int radius, const overmap_path_params &params,
+        const std::unordered_set<point> *corridor )
 {
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
-    return is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type );
+    // Paths are mostly along one overmap at a time, so look it up only when it changes
+    point_abs_om om_pos;
+    overmap *om = nullptr;
+    bool looked_up = false;
+    const auto estimate = [&]( const tripoint_abs_omt & pos ) {
+        if( corridor && !corridor->contains( travel_chunk_of( pos.xy() ) ) ) {
+            return pf::omt_score::rejected;
+        }
+        const auto [pos_om, local] = project_remain<coords::om>( pos.xy() );
+        if( !looked_up || pos_om != om_pos ) {
+            om = get_existing( pos_om );
+            om_pos = pos_om;
+            looked_up = true;
+        }
+        const tripoint_om_omt p( local, pos.z() );
+        const int cur_cost = pos == src ? 0 : get_terrain_cost( om, p, params );
+        if( cur_cost < 0 ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( cur_cost, om && om->ter( p )->is_travel_ramp() );
+    };
+    return pf::find_overmap_path( src, dest, radius, estimate ).points;
 }
 
 std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
@@ -835,17 +1163,30 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
-    const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
-        const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
-        if( cur_cost < 0 ) {
-            return pf::omt_score::rejected;
+    // Long paths are found a chunk of terrain at a time first, then only the chunks along that
+    // path are searched in detail.  That can miss paths the chunks don't show, so if nothing is
+    // found the whole area is searched after all.
+    if( src.z() == dest.z() && octile_dist( src.xy(), dest.xy() ) > 3 * overmap::travel_chunk_size ) {
+        const std::unordered_set<point> corridor = find_travel_corridor( src, dest, travel_path_radius,
+                params );
+        if( !corridor.empty() ) {
+            std::vector<tripoint_abs_omt> path = find_travel_path( src, dest, travel_path_radius, params,
+                                                 &corridor );
+            if( !path.empty() ) {
+                return path;
+            }
         }
-        return pf::omt_score( cur_cost, is_ramp( pos ) );
-    };
+    }
+    return find_travel_path( src, dest, travel_path_radius, params, nullptr );
+}
 
-    constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
-    return path.points;
+std::vector<tripoint_abs_omt> overmapbuffer::get_full_travel_path( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, overmap_path_params params )
+{
+    if( src == overmap::invalid_tripoint || dest == overmap::invalid_tripoint ) {
+        return {};
+    }
+    return find_travel_path( src, dest, travel_path_radius, params, nullptr );
 }
 
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
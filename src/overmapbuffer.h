@@ -9,6 +9,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,7 @@ class map_extra;
 class monster;
 class npc;
 class overmap;
+class overmap_noise_prefetcher;
 class overmap_special;
 class overmap_special_batch;
 class throbber_popup;
@@ -41,6 +43,11 @@ namespace om_direction
 enum class type;
 } // namespace om_direction
 
+namespace om_noise
+{
+struct om_noise_layers;
+} // namespace om_noise
+
 struct overmap_path_params {
     int road_cost = -1;
     int field_cost = -1;
@@ -150,6 +157,7 @@ class overmapbuffer
 {
     public:
         overmapbuffer();
+        ~overmapbuffer();
 
         static std::string terrain_filename( const point_abs_om & );
         static std::string player_filename( const point_abs_om & );
@@ -162,6 +170,20 @@ class overmapbuffer
         void save();
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
+        /**
+         * Starts sampling the noise layers of the not yet generated overmaps around @p center
+         * on a worker thread, so that generating one of them when it's entered doesn't have to.
+         * Cheap to call again with the same center.
+         */
+        void prefetch_around( const point_abs_om &center );
+        /**
+         * Noise layers of the overmap at @p p sampled by @ref prefetch_around with @p seed,
+         * waits for them if they're being sampled.  Null if they weren't prefetched.
+         */
+        std::shared_ptr<const om_noise::om_noise_layers> take_prefetched_noise(
+            const point_abs_om &p, unsigned seed );
+        /** Waits until all noise layers asked for by @ref prefetch_around are sampled. */
+        void wait_for_prefetched_noise();
 
         /**
          * Returns the overmap terrain at the given OMT coordinates.
@@ -344,8 +366,19 @@ class overmapbuffer
         bool reveal( const tripoint_abs_omt &center, int radius );
         bool reveal( const tripoint_abs_omt &center, int radius,
                      const std::function<bool( const oter_id & )> &filter );
+        /**
+         * Travel path from @p src to @p dest.  Long paths are first found across chunks of
+         * terrain (see @ref overmap::travel_chunk_size), so they can be a bit longer than
+         * the best path.
+         */
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
+        /**
+         * Same as @ref get_travel_path, but searches all terrains in the area right away.
+         * Much slower for long paths.
+         */
+        std::vector<tripoint_abs_omt> get_full_travel_path(
+            const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            const omt_route_params &params );
         /**
@@ -508,6 +541,16 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * Chunks (see @ref overmap::travel_chunk_size) that a travel path from @p src
+         * to @p dest likely goes through, and those around them.  Empty if none was found.
+         */
+        std::unordered_set<point> find_travel_corridor( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, int radius, const overmap_path_params &params );
+        // Travel path that only goes through the chunks in @p corridor, if given
+        std::vector<tripoint_abs_omt> find_travel_path( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, int radius, const overmap_path_params &params,
+                const std::unordered_set<point> *corridor );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -517,6 +560,8 @@ class overmapbuffer
         mutable std::set<point_abs_om> known_non_existing;
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
+        std::unique_ptr<overmap_noise_prefetcher> noise_prefetcher;
+        std::optional<point_abs_om> last_prefetch_center;
 
         /**
          * Get a list of notes in the (loaded) overmaps.
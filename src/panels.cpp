@@ -1,15 +1,19 @@
 #include "panels.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iosfwd>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "action.h"
 #include "avatar.h"
@@ -52,6 +56,7 @@
 #include "string_id.h"
 #include "tileray.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui_manager.h"
 #include "units.h"
@@ -1850,6 +1855,44 @@ static void draw_ai_goal( const avatar &u, const catacurses::window &w )
     wnoutrefresh( w );
 }
 
+static void draw_turn_profile( const avatar &, const catacurses::window &w )
+{
+    werase( w );
+    const std::vector<turn_profiler::turn_summary> &turns = turn_profiler::recent_turns();
+    if( !turn_profiler::is_enabled() || turns.empty() ) {
+        // NOLINTNEXTLINE(cata-use-named-point-constants)
+        mvwprintz( w, point( 1, 0 ), c_light_gray, _( "Turn profiler is off, see the debug menu." ) );
+        wnoutrefresh( w );
+        return;
+    }
+    const auto ms = []( std::int64_t ns ) {
+        return ns / 1000000.0;
+    };
+    const turn_profiler::turn_summary &last = turns.back();
+    std::int64_t frame_total = 0;
+    for( const turn_profiler::turn_summary &turn : turns ) {
+        frame_total += turn.frame_ns;
+    }
+    mvwprintz( w, point_zero, c_light_gray, string_format( " %-15s%7s%7s", "ms", "last", "avg" ) );
+    mvwprintz( w, point_south, c_white, string_format( " %-15s%7.2f%7.2f", "frame",
+               ms( last.frame_ns ), ms( frame_total / static_cast<std::int64_t>( turns.size() ) ) ) );
+    const std::vector<turn_profiler::zone_total> average = turn_profiler::average_turn();
+    const int lines = std::min<int>( average.size(), getmaxy( w ) - 2 );
+    for( int i = 0; i < lines; i++ ) {
+        const turn_profiler::zone_total &zone = average[i];
+        const auto in_last = std::find_if( last.zones.begin(), last.zones.end(),
+        [&zone]( const turn_profiler::zone_total & z ) {
+            return std::strcmp( z.name, zone.name ) == 0;
+        } );
+        const double last_ms = in_last == last.zones.end() ? 0.0 : ms( in_last->ns );
+        // Turns much slower than usual stand out
+        mvwprintz( w, point( 0, i + 2 ), last_ms > 2 * ms( zone.ns ) ? c_yellow : c_light_gray,
+                   string_format( " %-15s%7.2f%7.2f", utf8_truncate( zone.name, 15 ), last_ms,
+                                  ms( zone.ns ) ) );
+    }
+    wnoutrefresh( w );
+}
+
 static void draw_location_classic( const avatar &u, const catacurses::window &w )
 {
     werase( w );
@@ -2069,6 +2112,7 @@ static std::vector<window_panel> initialize_default_classic_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_profile, "Turn Profile", 10, 44, false );
     return ret;
 }
 
@@ -2095,6 +2139,7 @@ static std::vector<window_panel> initialize_default_compact_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_profile, "Turn Profile", 10, 32, false );
 
     return ret;
 }
@@ -2127,6 +2172,7 @@ static std::vector<window_panel> initialize_default_label_narrow_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_profile, "Turn Profile", 10, 32, false );
 
     return ret;
 }
@@ -2160,6 +2206,7 @@ static std::vector<window_panel> initialize_default_label_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_profile, "Turn Profile", 10, 44, false );
 
     return ret;
 }
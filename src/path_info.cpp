@@ -35,6 +35,7 @@ static std::string savedir_value;
 static std::string autopickup_value;
 static std::string options_value;
 static std::string memorialdir_value;
+static std::string data_cache_dir_value;
 
 void PATH_INFO::init_base_path( std::string path )
 {
@@ -92,6 +93,7 @@ void PATH_INFO::set_standard_filenames()
 
     savedir_value = user_dir_value + "save/";
     memorialdir_value = user_dir_value + "memorial/";
+    data_cache_dir_value = user_dir_value + "cache/";
 
 #if defined(USE_XDG_DIR)
     const char *user_dir;
@@ -153,6 +155,10 @@ std::string PATH_INFO::custom_colors()
 {
     return config_dir_value + "custom_colors.json";
 }
+std::string PATH_INFO::data_cache_dir()
+{
+    return data_cache_dir_value;
+}
 std::string PATH_INFO::datadir()
 {
     return datadir_value;
@@ -277,6 +283,10 @@ std::string PATH_INFO::crash()
 {
     return config_dir_value + "crash.log";
 }
+std::string PATH_INFO::turn_profile()
+{
+    return config_dir_value + "turn_profile.json";
+}
 std::string PATH_INFO::tileset_conf()
 {
     return "tileset.txt";
@@ -362,6 +372,11 @@ void PATH_INFO::set_memorialdir( const std::string &memorialdir )
     memorialdir_value = memorialdir;
 }
 
+void PATH_INFO::set_data_cache_dir( const std::string &data_cache_dir )
+{
+    data_cache_dir_value = data_cache_dir;
+}
+
 void PATH_INFO::set_options( const std::string &options )
 {
     options_value = options;
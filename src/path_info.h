@@ -19,6 +19,7 @@ std::string colors();
 std::string color_templates();
 std::string config_dir();
 std::string custom_colors();
+std::string data_cache_dir();
 std::string datadir();
 std::string debug();
 std::string defaultsounddir();
@@ -48,6 +49,7 @@ std::string user_keybindings();
 std::string user_moddir();
 std::string worldoptions();
 std::string crash();
+std::string turn_profile();
 std::string tileset_conf();
 std::string gfxdir();
 std::string user_gfx();
@@ -68,6 +70,7 @@ void set_datadir( const std::string &datadir );
 void set_config_dir( const std::string &config_dir );
 void set_savedir( const std::string &savedir );
 void set_memorialdir( const std::string &memorialdir );
+void set_data_cache_dir( const std::string &data_cache_dir );
 void set_options( const std::string &options );
 void set_autopickup( const std::string &autopickup );
 void set_motd( const std::string &motd );
@@ -44,37 +44,54 @@ struct path_data_layer {
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
+    // Indices written to during the current search, so that the next search
+    // only has to reset those instead of the whole layer
+    std::vector<int> touched;
 
-    void init( point min, point max ) {
-        tripoint p;
-        for( p.x = min.x; p.x <= max.x; p.x++ ) {
-            for( p.y = min.y; p.y <= max.y; p.y++ ) {
-                const int ind = flat_index( p );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    void mark( const int index ) {
+        if( state[index] == ASL_NONE ) {
+            touched.push_back( index );
         }
     }
+
+    void reset() {
+        for( const int index : touched ) {
+            state[index] = ASL_NONE;
+            score[index] = 0;
+            gscore[index] = 0;
+        }
+        touched.clear();
+    }
 };
 
+// Search state is kept between calls to map::route, as allocating and clearing
+// whole layers for every route request was the bulk of the cost of short routes.
+// Layers are reset lazily, so a layer untouched by a search reads as all zero,
+// same as a freshly allocated one.
 struct pathfinder {
     point min;
     point max;
-    pathfinder( point _min, point _max ) :
-        min( _min ), max( _max ) {
-    }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    std::array< bool, OVERMAP_LAYERS > layer_in_use;
+
+    void reset( point _min, point _max ) {
+        min = _min;
+        max = _max;
+        open.clear();
+        layer_in_use.fill( false );
+    }
 
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
+        }
+        if( !layer_in_use[z + OVERMAP_DEPTH] ) {
+            ptr->reset();
+            layer_in_use[z + OVERMAP_DEPTH] = true;
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
         return *ptr;
     }
 
@@ -83,9 +100,10 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
@@ -96,16 +114,19 @@ struct pathfinder {
             return;
         }
 
+        layer.mark( index );
         layer.state [index] = ASL_OPEN;
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.emplace( score, to );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p );
+        layer.mark( index );
         layer.state[index] = ASL_CLOSED;
     }
 
@@ -116,6 +137,13 @@ struct pathfinder {
     }
 };
 
+static pathfinder &get_pathfinder( point min, point max )
+{
+    static pathfinder pf;
+    pf.reset( min, max );
+    return pf;
+}
+
 // Modifies `t` to be a tile with `flag` in the overmap tile that `t` was originally on
 // return false if it could not find a suitable point
 template<ter_bitflags flag>
@@ -192,6 +220,179 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+// 7 3 5
+// 1 . 2
+// 6 4 8
+static constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+static constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+
+static constexpr pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+// Straight line from f to t over flat, unremarkable ground, stored in `line_path`
+static bool straight_route( const pathfinding_cache &pf_cache, const tripoint &f,
+                            const tripoint &t, const std::set<tripoint> &pre_closed,
+                            std::vector<tripoint> &line_path )
+{
+    line_path = line_to( f, t );
+    // Check all points for any special case (including just hard terrain)
+    if( !( pf_cache.special[f.x][f.y] & non_normal ) &&
+    std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+    return !( pf_cache.special[p.x][p.y] & non_normal );
+    } ) ) {
+        const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
+
+        if( is_disjoint( sorted_line, pre_closed ) ) {
+            return true;
+        }
+    }
+
+    line_path.clear();
+    return false;
+}
+
+route_step map::route_step_cost( const tripoint &cur, const vehicle *cur_veh, const tripoint &p,
+                                 const pf_special p_special,
+                                 const pathfinding_settings &settings ) const
+{
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+    const bool trapavoid = settings.avoid_traps;
+
+    route_step ret;
+    int part = -1;
+    const vehicle *veh = veh_at_internal( p, part );
+    if( cur_veh &&
+        !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
+        //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
+        ret.type = route_step::kind::skip;
+        return ret;
+    }
+
+    if( veh && veh != cur_veh &&
+        !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
+        //Same as above but moving into rather than out of a vehicle
+        ret.type = route_step::kind::skip;
+        return ret;
+    }
+
+    // Penalize for diagonals or the path will look "unnatural"
+    int newg = ( cur.x != p.x && cur.y != p.y ) ? 1 : 0;
+
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        ret.type = route_step::kind::passable;
+        ret.cost = newg + 2;
+        return ret;
+    }
+
+    if( settings.avoid_rough_terrain ) {
+        // Close all rough terrain tiles
+        return ret;
+    }
+
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        // Close it so that next time we won't try to calculate costs
+        return ret;
+    }
+
+    newg += cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            newg += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                     !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            newg += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( cur, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                newg += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->cpart( part ).hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    return ret;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                newg += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) ) {
+                    ret.type = route_step::kind::skip;
+                }
+                // Otherwise won't be openable, don't try from other sides
+                return ret;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            newg += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            newg += 500;
+        } else {
+            // Unbashable and unopenable from here
+            if( doors && terrain.open && furniture.open ) {
+                ret.type = route_step::kind::skip;
+            }
+            // Otherwise from anywhere else for that matter
+            return ret;
+        }
+    }
+
+    if( trapavoid && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    ret.type = route_step::kind::ledge;
+                    return ret;
+                }
+            } else {
+                // Otherwise it's walkable
+                newg += 500;
+            }
+        }
+    }
+
+    if( settings.avoid_sharp && p_special & PF_SHARP ) {
+        // Avoid sharp things
+        return ret;
+    }
+
+    ret.type = route_step::kind::passable;
+    ret.cost = newg;
+    return ret;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -212,21 +413,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
-    if( f.z == t.z ) {
-        const auto line_path = line_to( f, t );
-        const auto &pf_cache = get_pathfinding_cache_ref( f.z );
-        // Check all points for any special case (including just hard terrain)
-        if( !( pf_cache.special[f.x][f.y] & non_normal ) &&
-        std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
-        return !( pf_cache.special[p.x][p.y] & non_normal );
-        } ) ) {
-            const std::set<tripoint> sorted_line( line_path.begin(), line_path.end() );
-
-            if( is_disjoint( sorted_line, pre_closed ) ) {
-                return line_path;
-            }
-        }
+    if( f.z == t.z && straight_route( get_pathfinding_cache_ref( f.z ), f, t, pre_closed, ret ) ) {
+        return ret;
     }
 
     // If expected path length is greater than max distance, allow only line path, like above
@@ -234,13 +422,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
-    int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
+    const int max_length = settings.max_length;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     int minx = std::min( f.x, t.x ) - pad;
@@ -254,7 +436,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( point( minx, miny ), point( maxx, maxy ) );
+    pathfinder &pf = get_pathfinder( point( minx, miny ), point( maxx, maxy ) );
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -298,11 +480,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         int cur_part;
         const vehicle *cur_veh = veh_at_internal( cur, cur_part );
 
-        // 7 3 5
-        // 1 . 2
-        // 6 4 8
-        constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
-        constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
         for( size_t i = 0; i < 8; i++ ) {
             const tripoint p( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
             const int index = flat_index( p );
@@ -316,145 +493,31 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            int part = -1;
-            const vehicle *veh = veh_at_internal( p, part );
-            if( cur_veh &&
-                !cur_veh->allowed_move( cur_veh->tripoint_to_mount( cur ), cur_veh->tripoint_to_mount( p ) ) ) {
-                //Trying to squeeze through a vehicle hole, skip this movement but don't close the tile as other paths may lead to it
+            const route_step step = route_step_cost( cur, cur_veh, p, pf_cache.special[p.x][p.y],
+                                    settings );
+            if( step.type == route_step::kind::skip ) {
                 continue;
-            }
-
-            if( veh && veh != cur_veh &&
-                !veh->allowed_move( veh->tripoint_to_mount( cur ), veh->tripoint_to_mount( p ) ) ) {
-                //Same as above but moving into rather than out of a vehicle
+            } else if( step.type == route_step::kind::closed ) {
+                // Close it so that next time we won't try to calculate costs
+                pf.close_point( p );
                 continue;
-            }
-
-            // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
-                }
-
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->cpart( part ).hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
-
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+            } else if( step.type == route_step::kind::ledge ) {
+                tripoint below( p.xy(), p.z - 1 );
+                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
+                    // Otherwise this would have been a huge fall
+                    auto &layer = pf.get_layer( p.z - 1 );
+                    // From cur, not p, because we won't be walking on air
+                    pf.add_point( layer.gscore[parent_index] + 10,
+                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                  cur, below );
                 }
 
+                // Close p, because we won't be walking on it
+                pf.close_point( p );
+                continue;
             }
 
+            const int newg = layer.gscore[parent_index] + step.cost;
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
             if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
@@ -549,3 +612,194 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
     return ret;
 }
+
+void shared_route_cache::start_turn( const time_point &now, const tripoint &map_abs_sub )
+{
+    if( turn == now && abs_sub == map_abs_sub ) {
+        return;
+    }
+    turn = now;
+    abs_sub = map_abs_sub;
+    fields_in_use = 0;
+    requested.clear();
+}
+
+route_field *shared_route_cache::find( const tripoint &target,
+                                       const pathfinding_settings &settings )
+{
+    for( size_t i = 0; i < fields_in_use; i++ ) {
+        route_field &field = *fields[i];
+        if( field.target == target && field.settings == settings ) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+route_field &shared_route_cache::add( const tripoint &target,
+                                      const pathfinding_settings &settings )
+{
+    if( fields_in_use == fields.size() ) {
+        fields.emplace_back( std::make_unique<route_field>() );
+    }
+    route_field &field = *fields[fields_in_use++];
+    field.target = target;
+    field.settings = settings;
+    return field;
+}
+
+bool shared_route_cache::note_request( const tripoint &target,
+                                       const pathfinding_settings &settings )
+{
+    const std::pair<tripoint, pathfinding_settings> request( target, settings );
+    if( std::find( requested.begin(), requested.end(), request ) != requested.end() ) {
+        return true;
+    }
+    requested.emplace_back( request );
+    return false;
+}
+
+void map::build_route_field( route_field &field ) const
+{
+    const tripoint &t = field.target;
+    const pathfinding_settings &settings = field.settings;
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+    field.cache_generation = pf_cache.generation;
+    field.has_ledges = false;
+
+    // Cover every tile map::route could explore for a source within max_dist of the target
+    const int pad = 16;
+    const int radius = settings.max_dist + pad;
+    int minz = t.z;
+    int maxz = t.z;
+    field.min = t.xy() - point( radius, radius );
+    field.max = t.xy() + point( radius, radius );
+    clip_to_bounds( field.min.x, field.min.y, minz );
+    clip_to_bounds( field.max.x, field.max.y, maxz );
+
+    for( int x = field.min.x; x <= field.max.x; x++ ) {
+        std::fill_n( &field.dist[flat_index( tripoint( x, field.min.y, t.z ) )],
+                     field.max.y - field.min.y + 1, route_field::unreachable );
+    }
+
+    // Dijkstra outwards from the target, over reversed steps
+    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
+    open;
+    field.dist[flat_index( t )] = 0;
+    open.emplace( 0, t );
+    while( !open.empty() ) {
+        const auto top = open.top();
+        open.pop();
+        const tripoint &cur = top.second;
+        const int cur_dist = field.dist[flat_index( cur )];
+        if( top.first > cur_dist ) {
+            continue;
+        }
+        if( cur_dist > settings.max_length ) {
+            // Nothing further out could be routed to anyway
+            break;
+        }
+
+        const pf_special cur_special = pf_cache.special[cur.x][cur.y];
+        for( size_t i = 0; i < 8; i++ ) {
+            const tripoint from( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
+            if( !field.covers( from ) ) {
+                continue;
+            }
+
+            int part = -1;
+            const vehicle *from_veh = veh_at_internal( from, part );
+            const route_step step = route_step_cost( from, from_veh, cur, cur_special, settings );
+            if( step.type == route_step::kind::ledge ) {
+                field.has_ledges = true;
+            }
+            if( step.type != route_step::kind::passable ) {
+                continue;
+            }
+
+            const int new_dist = cur_dist + step.cost;
+            int &from_dist = field.dist[flat_index( from )];
+            if( new_dist < from_dist ) {
+                from_dist = new_dist;
+                open.emplace( new_dist, from );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::route_shared( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed ) const
+{
+    if( !pre_closed.empty() || f == t || f.z != t.z || !inbounds( f ) || !inbounds( t ) ||
+        rl_dist( f, t ) > settings.max_dist ) {
+        return route( f, t, settings, pre_closed );
+    }
+
+    std::vector<tripoint> ret;
+    // Straight lines are cheaper than anything the field could offer
+    if( straight_route( get_pathfinding_cache_ref( f.z ), f, t, {}, ret ) ) {
+        return ret;
+    }
+
+    shared_route_cache &cache = *shared_routes;
+    cache.start_turn( calendar::turn, abs_sub );
+    route_field *field = cache.find( t, settings );
+    if( field == nullptr ) {
+        if( !cache.note_request( t, settings ) ) {
+            cache.stats.misses++;
+            return route( f, t, settings );
+        }
+        field = &cache.add( t, settings );
+        build_route_field( *field );
+        cache.stats.fields++;
+    } else if( field->cache_generation != get_pathfinding_cache_ref( t.z ).generation ) {
+        build_route_field( *field );
+        cache.stats.fields++;
+    }
+
+    if( field->has_ledges || !field->covers( f ) ) {
+        cache.stats.misses++;
+        return route( f, t, settings );
+    }
+
+    cache.stats.hits++;
+    const int start_dist = field->dist[flat_index( f )];
+    if( start_dist == route_field::unreachable || start_dist > settings.max_length ) {
+        return ret;
+    }
+
+    // Walk down the field, picking neighbours in the same order map::route would
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+    tripoint cur = f;
+    while( cur != t ) {
+        const int cur_dist = field->dist[flat_index( cur )];
+        int part = -1;
+        const vehicle *cur_veh = veh_at_internal( cur, part );
+        bool stepped = false;
+        for( size_t i = 0; i < 8 && !stepped; i++ ) {
+            const tripoint p( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
+            if( !field->covers( p ) || field->dist[flat_index( p )] == route_field::unreachable ) {
+                continue;
+            }
+            const route_step step = route_step_cost( cur, cur_veh, p, pf_cache.special[p.x][p.y],
+                                    settings );
+            if( step.type == route_step::kind::passable &&
+                step.cost + field->dist[flat_index( p )] == cur_dist ) {
+                ret.push_back( p );
+                cur = p;
+                stepped = true;
+            }
+        }
+        if( !stepped ) {
+            debugmsg( "Shared route field has no step down from %d:%d:%d", cur.x, cur.y, cur.z );
+            return route( f, t, settings );
+        }
+    }
+
+    return ret;
+}
+
+const shared_route_stats &map::get_shared_route_stats() const
+{
+    return shared_routes->stats;
+}
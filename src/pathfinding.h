@@ -2,7 +2,15 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <climits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -43,6 +51,8 @@ struct pathfinding_cache {
     ~pathfinding_cache() = default;
 
     bool dirty;
+    // Incremented every time the cache is rebuilt, lets dependent caches notice changes
+    int generation = 0;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
 };
@@ -71,6 +81,75 @@ struct pathfinding_settings {
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
     pathfinding_settings &operator = ( const pathfinding_settings & ) = default;
+    bool operator==( const pathfinding_settings &rhs ) const = default;
+};
+
+// Outcome of a single step considered by the route pathfinder
+struct route_step {
+    enum class kind : int {
+        passable,   // Can step there for `cost`
+        skip,       // Can't step there from this direction, but maybe from another
+        closed,     // Can't step there from any direction
+        ledge,      // Stepping there means dropping down a z-level
+    };
+
+    kind type = kind::closed;
+    int cost = 0;
+};
+
+/**
+ * Distance field towards a single target on a single z-level, built over the
+ * same step costs as map::route. Lets all the routes requested towards that
+ * target with the same settings in one turn be read off it instead of running
+ * A* for each of them.
+ */
+struct route_field {
+    tripoint target;
+    pathfinding_settings settings;
+    // Inclusive bounds of the area covered by the field
+    point min;
+    point max;
+    // Generation of the pathfinding cache the field was built from
+    int cache_generation = 0;
+    // Field can't represent routes that drop down ledges, A* has to handle those
+    bool has_ledges = false;
+    std::array<int, MAPSIZE_X *MAPSIZE_Y> dist;
+
+    static constexpr int unreachable = INT_MAX;
+
+    bool covers( const tripoint &p ) const {
+        return p.z == target.z && p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+};
+
+struct shared_route_stats {
+    // Routes read off a shared field
+    int hits = 0;
+    // Routes that had to be computed by A*
+    int misses = 0;
+    // Fields built
+    int fields = 0;
+};
+
+/**
+ * Per-turn store of route fields, see map::route_shared.
+ * A field is only built for a target and settings bundle once a second request
+ * for it comes in during the same turn, so lone pathers never pay for one.
+ */
+struct shared_route_cache {
+    time_point turn = calendar::before_time_starts;
+    tripoint abs_sub;
+    std::vector<std::unique_ptr<route_field>> fields;
+    // Number of fields in `fields` valid this turn, the rest are kept for reuse
+    size_t fields_in_use = 0;
+    std::vector<std::pair<tripoint, pathfinding_settings>> requested;
+    shared_route_stats stats;
+
+    void start_turn( const time_point &now, const tripoint &map_abs_sub );
+    route_field *find( const tripoint &target, const pathfinding_settings &settings );
+    route_field &add( const tripoint &target, const pathfinding_settings &settings );
+    // Returns true if the same request was already made this turn
+    bool note_request( const tripoint &target, const pathfinding_settings &settings );
 };
 
 #endif // CATA_SRC_PATHFINDING_H
@@ -211,7 +211,7 @@ class player : public Character
             const std::function<bool( const item & )> &filter ) const;
         comp_selection<item_comp>
         select_item_component( const std::vector<item_comp> &components,
-                               int batch, inventory &map_inv, bool can_cancel = false,
+                               int batch, const inventory &map_inv, bool can_cancel = false,
                                const std::function<bool( const item & )> &filter = return_true<item>, bool player_inv = true );
         std::vector<detached_ptr<item>> consume_items( const comp_selection<item_comp> &is, int batch,
                                      const std::function<bool( const item & )> &filter = return_true<item> );
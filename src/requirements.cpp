@@ -10,6 +10,7 @@
 #include <memory>
 #include <set>
 #include <stack>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -761,6 +762,110 @@ bool requirement_data::has_comps( const inventory &crafting_inv,
     return retval;
 }
 
+std::vector<bool> requirement_data::could_make_with_inventory(
+    const std::vector<const requirement_data *> &reqs, const inventory &crafting_inv, int batch,
+    cost_adjustment flags )
+{
+    std::vector<bool> result( reqs.size(), true );
+    if( g->u.has_trait( trait_DEBUG_HS ) ) {
+        return result;
+    }
+
+    // Groups that may be fulfilled without the item type being present are left out,
+    // as are the quality groups if the inventory has no quality cache to look them up in
+    const bool use_qualities = !crafting_inv.get_quality_cache().empty();
+    const auto needs_present_tool = [batch, flags]( const tool_comp & tool ) {
+        if( tool.type == itype_UPS ) {
+            return false;
+        }
+        if( !tool.by_charges() ) {
+            return tool.count != 0;
+        }
+        int charges_required = tool.count * batch;
+        if( flags == cost_adjustment::start_only ) {
+            charges_required = crafting::charges_for_starting( charges_required );
+        } else if( flags == cost_adjustment::continue_only ) {
+            charges_required = crafting::charges_for_continuing( charges_required );
+        }
+        return charges_required > 0;
+    };
+    const auto needs_present_component = [batch]( const item_comp & comp ) {
+        return comp.type != itype_UPS && comp.count * batch != 0;
+    };
+    const auto needs_present_quality = [use_qualities]( const quality_requirement & qual ) {
+        return use_qualities && qual.count > 0;
+    };
+
+    // Groups not yet known to have anything present, per requirement
+    std::vector<int> missing( reqs.size(), 0 );
+    // Requirement each indexed group belongs to
+    std::vector<size_t> group_owner;
+    std::unordered_map<itype_id, std::vector<size_t>> groups_by_type;
+    std::unordered_map<quality_id, std::vector<std::pair<int, size_t>>> groups_by_quality;
+    const auto add_group = [&]( size_t req, const auto & group, const auto & needs_present,
+    const auto & index ) {
+        if( !std::all_of( group.begin(), group.end(), needs_present ) ) {
+            return;
+        }
+        const size_t id = group_owner.size();
+        group_owner.push_back( req );
+        missing[req]++;
+        for( const auto &comp : group ) {
+            index( comp, id );
+        }
+    };
+    const auto index_type = [&groups_by_type]( const auto & comp, size_t id ) {
+        groups_by_type[comp.type].push_back( id );
+    };
+    const auto index_quality = [&groups_by_quality]( const quality_requirement & qual, size_t id ) {
+        groups_by_quality[qual.type].emplace_back( qual.level, id );
+    };
+    for( size_t i = 0; i < reqs.size(); i++ ) {
+        for( const std::vector<quality_requirement> &group : reqs[i]->qualities ) {
+            add_group( i, group, needs_present_quality, index_quality );
+        }
+        for( const std::vector<tool_comp> &group : reqs[i]->tools ) {
+            add_group( i, group, needs_present_tool, index_type );
+        }
+        for( const std::vector<item_comp> &group : reqs[i]->components ) {
+            add_group( i, group, needs_present_component, index_type );
+        }
+    }
+
+    std::vector<bool> found( group_owner.size(), false );
+    const auto mark_found = [&]( size_t id ) {
+        if( !found[id] ) {
+            found[id] = true;
+            missing[group_owner[id]]--;
+        }
+    };
+    for( const auto &bin : crafting_inv.get_binned_items() ) {
+        const auto iter = groups_by_type.find( bin.first );
+        if( iter != groups_by_type.end() ) {
+            std::for_each( iter->second.begin(), iter->second.end(), mark_found );
+        }
+    }
+    if( use_qualities ) {
+        for( const auto &qual : crafting_inv.get_quality_cache() ) {
+            const auto iter = groups_by_quality.find( qual.first );
+            if( iter == groups_by_quality.end() || qual.second.empty() ) {
+                continue;
+            }
+            const int best_level = qual.second.rbegin()->first;
+            for( const std::pair<int, size_t> &group : iter->second ) {
+                if( group.first <= best_level ) {
+                    mark_found( group.second );
+                }
+            }
+        }
+    }
+
+    for( size_t i = 0; i < reqs.size(); i++ ) {
+        result[i] = missing[i] == 0;
+    }
+    return result;
+}
+
 bool quality_requirement::has(
     const inventory &crafting_inv, const std::function<bool( const item & )> &, int,
     cost_adjustment, const std::function<void( int )> & ) const
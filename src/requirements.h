@@ -328,6 +328,16 @@ struct requirement_data {
                                       const std::function<bool( const item & )> &filter, int batch = 1,
                                       cost_adjustment = cost_adjustment::none ) const;
 
+        /**
+         * Rules out all of @p reqs that @p crafting_inv has nothing for, in one pass.
+         * Indexes the requirement groups by the item types and qualities they use, then marks
+         * the groups something in the inventory is present for.  A false result means
+         * @ref can_make_with_inventory would fail, a true one still has to be checked with it.
+         */
+        static std::vector<bool> could_make_with_inventory(
+            const std::vector<const requirement_data *> &reqs, const inventory &crafting_inv,
+            int batch = 1, cost_adjustment = cost_adjustment::none );
+
         /** @param filter see @ref can_make_with_inventory */
         std::vector<std::string> get_folded_components_list( int width, nc_color col,
                 const inventory &crafting_inv, const std::function<bool( const item & )> &filter,
@@ -296,6 +296,7 @@ void scent_map::deserialize( const std::string &data, bool is_type )
                 val = stmp;
             }
         }
+        recalculate_nonzero_bounds();
     }
 }
 
@@ -15,6 +15,7 @@
 #include "map.h"
 #include "output.h"
 #include "string_id.h"
+#include "turn_profiler.h"
 
 static constexpr int SCENT_RADIUS = 40;
 
@@ -55,14 +56,62 @@ void scent_map::reset()
             val = 0;
         }
     }
+    nonzero_bounds.reset();
     typescent = scenttype_id();
 }
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
+    if( !nonzero_bounds ) {
+        return;
+    }
+    // Everything outside of the bounds is 0 already
+    const inclusive_rectangle<point> bounds = *nonzero_bounds;
+    for( int x = bounds.p_min.x; x <= bounds.p_max.x; ++x ) {
+        int *const column = grscent[x].data();
+        for( int y = bounds.p_min.y; y <= bounds.p_max.y; ++y ) {
+            column[y] = std::max( 0, column[y] - 1 );
+        }
+    }
+    // Scent only ever fades here, so this is where the bounds shrink
+    nonzero_bounds.reset();
+    for( int x = bounds.p_min.x; x <= bounds.p_max.x; ++x ) {
+        const int *const column = grscent[x].data();
+        int first = bounds.p_min.y;
+        while( first <= bounds.p_max.y && column[first] == 0 ) {
+            ++first;
+        }
+        if( first > bounds.p_max.y ) {
+            continue;
+        }
+        int last = bounds.p_max.y;
+        while( column[last] == 0 ) {
+            --last;
+        }
+        expand_nonzero_bounds( inclusive_rectangle<point>( point( x, first ), point( x, last ) ) );
+    }
+}
+
+void scent_map::expand_nonzero_bounds( const inclusive_rectangle<point> &area )
+{
+    if( !nonzero_bounds ) {
+        nonzero_bounds = area;
+        return;
+    }
+    nonzero_bounds->p_min.x = std::min( nonzero_bounds->p_min.x, area.p_min.x );
+    nonzero_bounds->p_min.y = std::min( nonzero_bounds->p_min.y, area.p_min.y );
+    nonzero_bounds->p_max.x = std::max( nonzero_bounds->p_max.x, area.p_max.x );
+    nonzero_bounds->p_max.y = std::max( nonzero_bounds->p_max.y, area.p_max.y );
+}
+
+void scent_map::recalculate_nonzero_bounds()
+{
+    nonzero_bounds.reset();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( grscent[x][y] != 0 ) {
+                expand_nonzero_bounds( inclusive_rectangle<point>( point( x, y ), point( x, y ) ) );
+            }
         }
     }
 }
@@ -89,6 +138,16 @@ void scent_map::shift( point sm_shift )
         }
     }
     grscent = new_scent;
+    if( nonzero_bounds ) {
+        const inclusive_rectangle<point> bounds( nonzero_bounds->p_min - sm_shift,
+                nonzero_bounds->p_max - sm_shift );
+        const inclusive_rectangle<point> map_bounds( point_zero, point( MAPSIZE_X - 1, MAPSIZE_Y - 1 ) );
+        if( bounds.overlaps( map_bounds ) ) {
+            nonzero_bounds.emplace( clamp( bounds.p_min, map_bounds ), clamp( bounds.p_max, map_bounds ) );
+        } else {
+            nonzero_bounds.reset();
+        }
+    }
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -109,6 +168,9 @@ void scent_map::set( const tripoint &p, int value, const scenttype_id &type )
 void scent_map::set_unsafe( const tripoint &p, int value, const scenttype_id &type )
 {
     grscent[p.x][p.y] = value;
+    if( value != 0 ) {
+        expand_nonzero_bounds( inclusive_rectangle<point>( p.xy(), p.xy() ) );
+    }
     if( !type.is_empty() ) {
         typescent = type;
     }
@@ -149,6 +211,7 @@ bool scent_map::inbounds( const tripoint &p ) const
 }
 void scent_map::update( const tripoint &center, map &m )
 {
+    CATA_TURN_ZONE( "scent" );
     // Stop updating scent after X turns of the player not moving.
     // Once wind is added, need to reset this on wind shifts as well.
     if( !player_last_position || center != *player_last_position ) {
@@ -158,89 +221,100 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
+    // Only the area around non-zero scent can change
+    if( !nonzero_bounds ) {
+        return;
+    }
+    const inclusive_rectangle<point> window( center.xy() - point( SCENT_RADIUS, SCENT_RADIUS ),
+            center.xy() + point( SCENT_RADIUS, SCENT_RADIUS ) );
+    const point min( std::max( nonzero_bounds->p_min.x - 1, window.p_min.x ),
+                     std::max( nonzero_bounds->p_min.y - 1, window.p_min.y ) );
+    const point max( std::min( nonzero_bounds->p_max.x + 1, window.p_max.x ),
+                     std::min( nonzero_bounds->p_max.y + 1, window.p_max.y ) );
+    if( min.x > max.x || min.y > max.y ) {
+        return;
+    }
+
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
-    scent_array<char> scent_transfer;
-
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+    static scent_array<char> scent_transfer;
+    // Sums of scent_transfer and scent_transfer * scent over the tile and the ones north and south of it
+    static scent_array<int> used_3_y;
+    static scent_array<int> sum_3_scent_y;
+    static scent_array<int> new_scent;
 
     diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
-
     // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
-    }
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+    m.scent_blockers( scent_transfer, min - point_south_east, max + point_south_east );
+
+    // Columns are contiguous in memory, so all the loops over y below can be vectorized
+    std::array<bool, MAPSIZE_X> column_has_vehicle_holes;
+    for( int x = min.x - 1; x <= max.x + 1; ++x ) {
+        const int *const scent = grscent[x].data();
+        const char *const transfer = scent_transfer[x].data();
+        int *const sum = sum_3_scent_y[x].data();
+        int *const used = used_3_y[x].data();
+        for( int y = min.y; y <= max.y; ++y ) {
+            sum[y] = transfer[y - 1] * scent[y - 1] + transfer[y] * scent[y] + transfer[y + 1] * scent[y + 1];
+            used[y] = transfer[y - 1] + transfer[y] + transfer[y + 1];
         }
+        bool has_holes = false;
+        for( int y = min.y - 1; y <= max.y; ++y ) {
+            has_holes |= blocked_cache[x][y].nw | blocked_cache[x][y].ne;
+        }
+        column_has_vehicle_holes[x] = has_holes;
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+    std::array<int, MAPSIZE_Y> squares_used;
+    std::array<int, MAPSIZE_Y> total;
+    for( int x = min.x; x <= max.x; ++x ) {
+        for( int y = min.y; y <= max.y; ++y ) {
+            squares_used[y] = used_3_y[x - 1][y] + used_3_y[x][y] + used_3_y[x + 1][y];
+            total[y] = sum_3_scent_y[x - 1][y] + sum_3_scent_y[x][y] + sum_3_scent_y[x + 1][y];
+        }
 
-            //handle vehicle holes
-            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
-            }
-            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+        //handle vehicle holes
+        if( column_has_vehicle_holes[x - 1] || column_has_vehicle_holes[x] ||
+            column_has_vehicle_holes[x + 1] ) {
+            for( int y = min.y; y <= max.y; ++y ) {
+                if( blocked_cache[x][y].nw && scent_transfer[x + 1][y + 1] == 5 ) {
+                    squares_used[y] -= 4;
+                    total[y] -= 4 * grscent[x + 1][y + 1];
+                }
+                if( blocked_cache[x][y].ne && scent_transfer[x - 1][y + 1] == 5 ) {
+                    squares_used[y] -= 4;
+                    total[y] -= 4 * grscent[x - 1][y + 1];
+                }
+                if( blocked_cache[x - 1][y - 1].nw && scent_transfer[x - 1][y - 1] == 5 ) {
+                    squares_used[y] -= 4;
+                    total[y] -= 4 * grscent[x - 1][y - 1];
+                }
+                if( blocked_cache[x + 1][y - 1].ne && scent_transfer[x + 1][y - 1] == 5 ) {
+                    squares_used[y] -= 4;
+                    total[y] -= 4 * grscent[x + 1][y - 1];
+                }
             }
+        }
 
+        const int *const scent = grscent[x].data();
+        const char *const transfer = scent_transfer[x].data();
+        int *const result = new_scent[x].data();
+        for( int y = min.y; y <= max.y; ++y ) {
             //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
+            int temp_scent = scent[y] * ( 250 - squares_used[y] * transfer[y] );
+            temp_scent -= scent[y] * transfer[y] * ( 45 - squares_used[y] ) / 5;
+            result[y] = ( temp_scent + total[y] * transfer[y] ) / 250;
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+
+    // Scent only spreads by one tile per update, the bounds shrink in decay()
+    for( int x = min.x; x <= max.x; ++x ) {
+        std::copy( new_scent[x].begin() + min.y, new_scent[x].begin() + max.y + 1,
+                   grscent[x].begin() + min.y );
     }
+    expand_nonzero_bounds( inclusive_rectangle<point>( min, max ) );
 }
 
 namespace
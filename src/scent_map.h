@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "calendar.h"
+#include "cuboid_rectangle.h"
 #include "enums.h" // IWYU pragma: keep
 #include "game_constants.h"
 #include "point.h"
@@ -46,12 +47,20 @@ class scent_map
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
         scent_array<int> grscent;
+        /**
+         * Contains every non-zero value of @ref grscent, may be larger than needed.
+         * Diffusion skips everything outside of it, since zeros surrounded by zeros stay zeros.
+         */
+        std::optional<inclusive_rectangle<point>> nonzero_bounds;
         scenttype_id typescent;
         std::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
         const game &gm;
 
+        void expand_nonzero_bounds( const inclusive_rectangle<point> &area );
+        void recalculate_nonzero_bounds();
+
     public:
         scent_map( const game &g ) : gm( g ) { }
 
@@ -129,7 +129,7 @@ directed_path<point> greedy_path( point source, point dest, point max,
     return res;
 }
 
-namespace
+namespace detail
 {
 
 const tripoint &direction_to_tripoint( direction dir )
@@ -153,7 +153,7 @@ const tripoint &direction_to_tripoint( direction dir )
     }
 }
 
-bool is_horizontal( direction dir )
+static bool is_horizontal( direction dir )
 {
     switch( dir ) {
         case direction::EAST:
@@ -166,39 +166,6 @@ bool is_horizontal( direction dir )
     }
 }
 
-/*
- * A node address annotated with its heuristic score, an approximation of how
- * much it would cost to reach the goal through this node.
- */
-struct scored_address {
-    tripoint_abs_omt addr;
-    int32_t score;
-    bool operator> ( const scored_address &other ) const {
-        return score > other.score;
-    }
-};
-
-/*
- * Data structure representing a navigation node that is known to be reachable. Contains
- * information about the path to get there and enough information to predict which nodes
- * may be reached from it.
- */
-struct navigation_node {
-    // Cost incurred to reach this node.
-    int32_t cumulative_cost;
-    // Cost of the node itself
-    int16_t node_cost;
-    // Direction towards the previous node in the path [3D].
-    // Compressed encoding of "direction" enum.
-    int8_t prev_dir;
-    // Whether z-level transitions are permitted from this node.
-    bool allow_z_change;
-
-    direction get_prev_dir() const {
-        return static_cast<direction>( prev_dir );
-    }
-};
-
 const std::vector<direction> &enumerate_directions( bool allow_z_change )
 {
     static const std::vector<direction> cardinal_dirs = {direction::EAST, direction::SOUTH, direction::WEST, direction::NORTH};
@@ -233,111 +200,11 @@ int adjust_omt_cost( int base_cost, direction dir_in, direction dir_out )
     return base_cost;
 }
 
-} // namespace
+} // namespace detail
 
 const omt_score omt_score::rejected( -1 );
 
 omt_score::omt_score( int node_cost, bool allow_z_change ) : node_cost( node_cost ),
     allow_z_change( allow_z_change ) {}
 
-simple_path<tripoint_abs_omt> find_overmap_path( const tripoint_abs_omt &source,
-        const tripoint_abs_omt &dest, const int radius, omt_scoring_fn scorer,
-        std::optional<int> max_cost )
-{
-    constexpr size_t max_search_count = 100000;
-    simple_path<tripoint_abs_omt> ret;
-    bool meet = false;
-
-    auto do_astar = [&]( const tripoint_abs_omt & start,
-                         std::unordered_map<tripoint_abs_omt, navigation_node> &known_nodes,
-                         std::priority_queue<scored_address, std::vector<scored_address>, std::greater<>> &open_set,
-    std::unordered_map<tripoint_abs_omt, navigation_node> &other_known_nodes ) {
-        const tripoint_abs_omt cur_addr = open_set.top().addr;
-        open_set.pop();
-        if( other_known_nodes.find( cur_addr ) != other_known_nodes.end() ) {
-            meet = true;
-            tripoint_abs_omt addr = cur_addr;
-            tripoint_abs_omt other_start = start == source ? dest : source;
-            while( addr != other_start ) {
-                ret.points.emplace_back( addr );
-                addr = addr + direction_to_tripoint( other_known_nodes.at( addr ).get_prev_dir() );
-            }
-            ret.points.emplace_back( addr );
-            addr = cur_addr;
-            while( addr != start ) {
-                addr = addr + direction_to_tripoint( known_nodes.at( addr ).get_prev_dir() );
-                ret.points.emplace_back( addr );
-            }
-            return;
-        }
-        const navigation_node &cur_node = known_nodes.at( cur_addr );
-        for( direction dir : enumerate_directions( cur_node.allow_z_change ) ) {
-            if( dir == cur_node.prev_dir ) {
-                continue; // don't go back the way we just came
-            }
-            const direction rev_dir = reverse_direction( dir );
-            const tripoint_abs_omt next_addr = cur_addr + direction_to_tripoint( dir );
-            const int cumulative_cost = cur_node.cumulative_cost + adjust_omt_cost( cur_node.node_cost, rev_dir,
-                                        cur_node.get_prev_dir() );
-            auto iter = known_nodes.find( next_addr );
-            if( iter != known_nodes.end() ) {
-                navigation_node &next_node = iter->second;
-                if( next_node.cumulative_cost > cumulative_cost ) {
-                    next_node.cumulative_cost = cumulative_cost;
-                    next_node.prev_dir = static_cast<int8_t>( rev_dir );
-                }
-            } else if( known_nodes.size() < max_search_count ) {
-                if( octile_dist( source.xy(), next_addr.xy() ) > radius ) {
-                    continue;
-                }
-                const omt_score next_score = scorer( next_addr );
-                if( next_score.node_cost < 0 ) {
-                    // TODO: add to closed set to avoid re-visiting
-                    continue;
-                }
-                // TODO: pass in the 10 (default terrain cost)
-                const int xy_score = octile_dist( next_addr.xy(), dest.xy(), 10 );
-                const int z_score = std::abs( next_addr.z() - dest.z() ) * 10;
-                const int estimated_total_cost = cumulative_cost + next_score.node_cost + xy_score + z_score;
-                if( max_cost && estimated_total_cost > *max_cost ) {
-                    continue;
-                }
-                navigation_node &next_node = known_nodes[next_addr];
-                next_node.cumulative_cost = cumulative_cost;
-                next_node.node_cost = next_score.node_cost;
-                next_node.prev_dir = static_cast<int8_t>( rev_dir );
-                next_node.allow_z_change = next_score.allow_z_change;
-                open_set.push( scored_address{ next_addr, estimated_total_cost } );
-            }
-        }
-    };
-    const omt_score start_score = scorer( source );
-    const omt_score end_score = scorer( dest );
-    if( start_score.node_cost < 0 || end_score.node_cost < 0 ) {
-        return ret;
-    }
-    std::unordered_map<tripoint_abs_omt, navigation_node> known_nodes_src;
-    std::priority_queue<scored_address, std::vector<scored_address>, std::greater<>> open_set_src;
-    known_nodes_src.emplace( source, navigation_node{0, 0, -1, start_score.allow_z_change} );
-    open_set_src.push( scored_address{ source, 0 } );
-
-    std::unordered_map<tripoint_abs_omt, navigation_node> known_nodes_dest;
-    std::priority_queue<scored_address, std::vector<scored_address>, std::greater<>> open_set_dest;
-    known_nodes_dest.emplace( dest, navigation_node{0, 0, -1, end_score.allow_z_change} );
-    open_set_dest.push( scored_address{ dest, 0 } );
-
-    int search_count = 0;
-    while( !open_set_src.empty() && !open_set_dest.empty() && !meet ) {
-        search_count++;
-        do_astar( source, known_nodes_src, open_set_src, known_nodes_dest );
-        if( meet ) {
-            return ret;
-        }
-        if( search_count > 10000 ) {
-            do_astar( dest, known_nodes_dest, open_set_dest, known_nodes_src );
-        }
-    }
-    return ret;
-}
-
 } // namespace pf
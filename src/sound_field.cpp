@@ -0,0 +1,72 @@
+#include "sound_field.h"
+
+#include <algorithm>
+
+#include "lightmap.h"
+#include "line.h"
+#include "map.h"
+#include "profile.h"
+
+void sound_field::compute( const map &m, const tripoint &src, int range )
+{
+    ZoneScoped;
+
+    source = src;
+    valid = m.inbounds( src );
+    if( !valid ) {
+        return;
+    }
+    const int reach = std::max( range - 1, 0 );
+    bounds = inclusive_rectangle<point>(
+                 point( std::max( src.x - reach, 0 ), std::max( src.y - reach, 0 ) ),
+                 point( std::min( src.x + reach, MAPSIZE_X - 1 ), std::min( src.y + reach, MAPSIZE_Y - 1 ) ) );
+    for( int x = bounds.p_min.x; x <= bounds.p_max.x; x++ ) {
+        std::fill( distance[x].begin() + bounds.p_min.y, distance[x].begin() + bounds.p_max.y + 1,
+                   unreached );
+    }
+    if( range <= 0 ) {
+        return;
+    }
+
+    const auto &transparency_cache = m.get_cache_ref( src.z ).transparency_cache;
+    if( open.size() < static_cast<size_t>( range ) ) {
+        open.resize( range );
+    }
+    distance[src.x][src.y] = 0;
+    open[0].emplace_back( src.xy() );
+    for( int dist = 0; dist < range; dist++ ) {
+        // Expanding a tile can't add tiles at the same distance, so this can be iterated
+        for( const point &p : open[dist] ) {
+            if( distance[p.x][p.y] != dist ) {
+                // Reached on a shorter path since it was added
+                continue;
+            }
+            for( const point &d : eight_adjacent_offsets ) {
+                const point next = p + d;
+                if( !bounds.contains( next ) ) {
+                    continue;
+                }
+                int &next_distance = distance[next.x][next.y];
+                const int new_distance = dist + 1 +
+                                         ( transparency_cache[next.x][next.y] <= LIGHT_TRANSPARENCY_SOLID ? wall_attenuation : 0 );
+                if( new_distance < range && ( next_distance == unreached || new_distance < next_distance ) ) {
+                    next_distance = new_distance;
+                    open[new_distance].emplace_back( next );
+                }
+            }
+        }
+        open[dist].clear();
+    }
+}
+
+std::optional<int> sound_field::muffling_at( const tripoint &p ) const
+{
+    if( !valid || p.z != source.z ) {
+        return 0;
+    }
+    if( !bounds.contains( p.xy() ) || distance[p.x][p.y] == unreached ) {
+        return std::nullopt;
+    }
+    // Without obstacles, the sound travels the same distance as the crow flies
+    return distance[p.x][p.y] - square_dist( source.xy(), p.xy() );
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef CATA_SRC_SOUND_FIELD_H
+#define CATA_SRC_SOUND_FIELD_H
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "cuboid_rectangle.h"
+#include "game_constants.h"
+#include "point.h"
+
+class map;
+
+/**
+ * How far a sound has to travel to reach each tile on its z-level of the reality bubble,
+ * going around obstacles.  Tiles that block sight (walls, closed doors and windows with
+ * curtains, vehicle boards) let the sound through, but muffle it as if it traveled
+ * @ref wall_attenuation more tiles.
+ *
+ * One field is computed per sound and shared by everything that hears it.
+ */
+class sound_field
+{
+    public:
+        static constexpr int wall_attenuation = 10;
+
+        /**
+         * Floods the field from a sound at @p source.  Tiles the sound would have to travel
+         * @p range or more tiles to reach are left out.
+         */
+        void compute( const map &m, const tripoint &source, int range );
+
+        /**
+         * Additional distance the sound travels to @p p because of obstacles, or std::nullopt
+         * if it doesn't reach @p p at all.  Tiles on other z-levels and sounds outside of the
+         * reality bubble aren't covered by the field, so they aren't muffled at all.
+         */
+        std::optional<int> muffling_at( const tripoint &p ) const;
+
+    private:
+        static constexpr int unreached = -1;
+
+        tripoint source;
+        bool valid = false;
+        inclusive_rectangle<point> bounds;
+        std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> distance;
+        // Dial's algorithm, tiles to expand by distance
+        std::vector<std::vector<point>> open;
+};
+
+#endif // CATA_SRC_SOUND_FIELD_H
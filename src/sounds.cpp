@@ -18,6 +18,7 @@
 #include "calendar.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
@@ -38,9 +39,11 @@
 #include "point.h"
 #include "rng.h"
 #include "safemode_ui.h"
+#include "sound_field.h"
 #include "string_formatter.h"
 #include "string_id.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -342,8 +345,11 @@ static int get_signal_for_hordes( const centroid &centr )
 void sounds::process_sounds()
 {
     ZoneScoped;
+    CATA_TURN_ZONE( "sounds" );
 
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
+    // Big, so it's reused between turns
+    static sound_field field;
     const int weather_vol = get_weather().weather_id->sound_attn;
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
@@ -363,9 +369,22 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Sound gets attenuated by at least 5 per z-level, so it can't reach further than this.
+        const int max_dist = vol * 2;
+        if( max_dist <= 0 ) {
+            continue;
+        }
+        // Walls between the sound and the monsters muffle it
+        field.compute( get_map(), source, max_dist );
+        for( monster *critter_ptr : g->critter_tracker->find_in_radius( source, max_dist,
+                max_dist / 5 ) ) {
+            monster &critter = *critter_ptr;
+            const std::optional<int> muffling = field.muffling_at( critter.pos() );
+            if( !muffling ) {
+                continue;
+            }
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = sound_distance( source, critter.pos() ) + *muffling;
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
                 critter.hear_sound( source, vol, dist );
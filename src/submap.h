@@ -25,7 +25,9 @@
 
 class JsonIn;
 class JsonOut;
+class binary_reader;
 class map;
+class submap_id_palette;
 struct trap;
 struct ter_t;
 struct furn_t;
@@ -217,7 +219,12 @@ class submap : maptile_soa<SEEX, SEEY>
         void rotate( int turns );
 
         void store( JsonOut &jsout ) const;
+        // Everything store writes, except for terrain, furniture, traps and radiation
+        void store_contents( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
+        // Terrain, furniture, traps and radiation in the binary format, see submap_binary.h
+        void store_binary_tiles( std::string &out, submap_id_palette &palette ) const;
+        void load_binary_tiles( binary_reader &in, submap_id_palette &palette );
 
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
@@ -0,0 +1,292 @@
+#include "submap_binary.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "json.h"
+#include "mapdata.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+
+void write_varint( std::string &out, std::uint32_t value )
+{
+    while( value >= 0x80 ) {
+        out.push_back( static_cast<char>( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast<char>( value ) );
+}
+
+void write_zigzag( std::string &out, std::int32_t value )
+{
+    write_varint( out, ( static_cast<std::uint32_t>( value ) << 1 ) ^
+                  static_cast<std::uint32_t>( value >> 31 ) );
+}
+
+std::uint32_t binary_reader::read_varint()
+{
+    std::uint32_t result = 0;
+    for( int shift = 0; shift < 35; shift += 7 ) {
+        if( data.empty() ) {
+            throw std::runtime_error( "unexpected end of binary data" );
+        }
+        const std::uint8_t byte = static_cast<std::uint8_t>( data.front() );
+        data.remove_prefix( 1 );
+        result |= static_cast<std::uint32_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ) {
+            return result;
+        }
+    }
+    throw std::runtime_error( "malformed integer in binary data" );
+}
+
+std::int32_t binary_reader::read_zigzag()
+{
+    const std::uint32_t value = read_varint();
+    return static_cast<std::int32_t>( ( value >> 1 ) ^ ( ~( value & 1 ) + 1 ) );
+}
+
+std::string_view binary_reader::read_bytes( size_t count )
+{
+    if( data.size() < count ) {
+        throw std::runtime_error( "unexpected end of binary data" );
+    }
+    std::string_view result = data.substr( 0, count );
+    data.remove_prefix( count );
+    return result;
+}
+
+template<typename T>
+std::uint32_t submap_id_palette::id_table<T>::index_of( const int_id<T> &id, bool &modified )
+{
+    const auto it = indices.find( id.to_i() );
+    if( it != indices.end() ) {
+        return it->second;
+    }
+    const std::uint32_t index = ids.size();
+    ids.emplace_back( id.id() );
+    resolved.emplace_back( id );
+    indices.emplace( id.to_i(), index );
+    modified = true;
+    return index;
+}
+
+template<typename T>
+int_id<T> submap_id_palette::id_table<T>::at( std::uint32_t index )
+{
+    if( index >= ids.size() ) {
+        throw std::runtime_error( string_format( "id index %d is not in the id palette", index ) );
+    }
+    if( !resolved[index] ) {
+        // Complains about the invalid id, same as loading it from JSON would
+        return ids[index].id();
+    }
+    return *resolved[index];
+}
+
+std::uint32_t submap_id_palette::index_of( const ter_id &id )
+{
+    return ter.index_of( id, modified );
+}
+
+std::uint32_t submap_id_palette::index_of( const furn_id &id )
+{
+    return furn.index_of( id, modified );
+}
+
+std::uint32_t submap_id_palette::index_of( const trap_id &id )
+{
+    return trp.index_of( id, modified );
+}
+
+ter_id submap_id_palette::ter_at( std::uint32_t index )
+{
+    return ter.at( index );
+}
+
+furn_id submap_id_palette::furn_at( std::uint32_t index )
+{
+    return furn.at( index );
+}
+
+trap_id submap_id_palette::trap_at( std::uint32_t index )
+{
+    return trp.at( index );
+}
+
+void submap_id_palette::serialize( JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "terrain", ter.ids );
+    jsout.member( "furniture", furn.ids );
+    jsout.member( "traps", trp.ids );
+    jsout.end_object();
+    modified = false;
+}
+
+template<typename T>
+static void read_id_table( const JsonObject &jo, const std::string &member,
+                           std::vector<string_id<T>> &ids,
+                           std::vector<std::optional<int_id<T>>> &resolved,
+                           std::unordered_map<int, std::uint32_t> &indices )
+{
+    ids.clear();
+    resolved.clear();
+    indices.clear();
+    for( const std::string id : jo.get_array( member ) ) {
+        const string_id<T> sid( id );
+        if( sid.is_valid() ) {
+            indices.emplace( sid.id().to_i(), ids.size() );
+            resolved.emplace_back( sid.id() );
+        } else {
+            resolved.emplace_back( std::nullopt );
+        }
+        ids.emplace_back( sid );
+    }
+}
+
+void submap_id_palette::deserialize( JsonIn &jsin )
+{
+    JsonObject jo = jsin.get_object();
+    read_id_table( jo, "terrain", ter.ids, ter.resolved, ter.indices );
+    read_id_table( jo, "furniture", furn.ids, furn.resolved, furn.indices );
+    read_id_table( jo, "traps", trp.ids, trp.resolved, trp.indices );
+    modified = false;
+}
+
+// Values are written in the same order as the JSON format, row by row
+template<typename F>
+static void write_runs( std::string &out, F value_at )
+{
+    std::uint32_t last = value_at( 0, 0 );
+    std::uint32_t count = 0;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const std::uint32_t value = value_at( i, j );
+            if( value != last ) {
+                write_varint( out, count );
+                write_varint( out, last );
+                last = value;
+                count = 0;
+            }
+            count++;
+        }
+    }
+    write_varint( out, count );
+    write_varint( out, last );
+}
+
+template<typename F>
+static void read_runs( binary_reader &in, F set_value )
+{
+    int i = 0;
+    int j = 0;
+    while( j < SEEY ) {
+        std::uint32_t count = in.read_varint();
+        const std::uint32_t value = in.read_varint();
+        if( count == 0 || count > static_cast<std::uint32_t>( ( SEEY - j ) * SEEX - i ) ) {
+            throw std::runtime_error( "corrupt run length in binary submap" );
+        }
+        for( ; count > 0; count-- ) {
+            set_value( i, j, value );
+            if( ++i == SEEX ) {
+                i = 0;
+                j++;
+            }
+        }
+    }
+}
+
+void submap::store_binary_tiles( std::string &out, submap_id_palette &palette ) const
+{
+    write_runs( out, [&]( int i, int j ) {
+        return palette.index_of( ter[i][j] );
+    } );
+    write_runs( out, [&]( int i, int j ) {
+        return palette.index_of( frn[i][j] );
+    } );
+    write_runs( out, [&]( int i, int j ) {
+        return palette.index_of( trp[i][j] );
+    } );
+    // Zigzag encoded, so that the odd negative value doesn't take 5 bytes
+    write_runs( out, [&]( int i, int j ) {
+        return ( static_cast<std::uint32_t>( rad[i][j] ) << 1 ) ^
+               static_cast<std::uint32_t>( rad[i][j] >> 31 );
+    } );
+}
+
+void submap::load_binary_tiles( binary_reader &in, submap_id_palette &palette )
+{
+    read_runs( in, [&]( int i, int j, std::uint32_t value ) {
+        ter[i][j] = palette.ter_at( value );
+    } );
+    read_runs( in, [&]( int i, int j, std::uint32_t value ) {
+        frn[i][j] = palette.furn_at( value );
+    } );
+    read_runs( in, [&]( int i, int j, std::uint32_t value ) {
+        trp[i][j] = palette.trap_at( value );
+    } );
+    read_runs( in, [&]( int i, int j, std::uint32_t value ) {
+        rad[i][j] = static_cast<int>( ( value >> 1 ) ^ ( ~( value & 1 ) + 1 ) );
+    } );
+}
+
+void write_binary_quad_header( std::string &out, std::uint32_t submap_count )
+{
+    out.append( binary_quad_magic );
+    write_varint( out, binary_quad_version );
+    write_varint( out, submap_count );
+}
+
+void write_binary_submap( std::string &out, const tripoint &pos, const submap &sm,
+                          submap_id_palette &palette )
+{
+    write_zigzag( out, pos.x );
+    write_zigzag( out, pos.y );
+    write_zigzag( out, pos.z );
+    write_varint( out, savegame_version );
+    sm.store_binary_tiles( out, palette );
+
+    std::ostringstream contents;
+    JsonOut jsout( contents );
+    jsout.start_object();
+    sm.store_contents( jsout );
+    jsout.end_object();
+    const std::string json = contents.str();
+    write_varint( out, json.size() );
+    out.append( json );
+}
+
+std::uint32_t read_binary_quad_header( binary_reader &in )
+{
+    if( in.read_bytes( binary_quad_magic.size() ) != binary_quad_magic ) {
+        throw std::runtime_error( "not a binary quad file" );
+    }
+    const std::uint32_t version = in.read_varint();
+    if( version > binary_quad_version ) {
+        throw std::runtime_error( string_format( "binary quad file version %d is newer than supported",
+                                  version ) );
+    }
+    return in.read_varint();
+}
+
+std::unique_ptr<submap> read_binary_submap( binary_reader &in, submap_id_palette &palette,
+        tripoint &pos )
+{
+    pos.x = in.read_zigzag();
+    pos.y = in.read_zigzag();
+    pos.z = in.read_zigzag();
+    const int version = in.read_varint();
+    std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( pos ) );
+    sm->load_binary_tiles( in, palette );
+
+    JsonIn jsin( in.read_bytes( in.read_varint() ) );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        sm->load( jsin, jsin.get_member_name(), version, multiply_xy( pos, 12 ) );
+    }
+    return sm;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef CATA_SRC_SUBMAP_BINARY_H
+#define CATA_SRC_SUBMAP_BINARY_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "int_id.h"
+#include "point.h"
+#include "string_id.h"
+#include "type_id.h"
+
+class JsonIn;
+class JsonOut;
+class submap;
+
+/**
+ * Binary quad files store the dense per-tile arrays of submaps (terrain, furniture, traps and
+ * radiation) as run-length encoded variable length integers, while everything else is
+ * stored as JSON, same as in regular quad files.
+ *
+ * Quad file layout, all integers are varints:
+ *   magic "CBNQ", format version, submap count,
+ *   for each submap: zigzag encoded x, y, z, savegame version,
+ *                    terrain, furniture, traps, radiation runs (count, value),
+ *                    length of the JSON object that follows, JSON object.
+ */
+constexpr std::string_view binary_quad_magic = "CBNQ";
+constexpr std::uint32_t binary_quad_version = 1;
+
+void write_varint( std::string &out, std::uint32_t value );
+void write_zigzag( std::string &out, std::int32_t value );
+
+/** Reads from a buffer of binary data, throws std::runtime_error if the data runs out. */
+class binary_reader
+{
+    public:
+        explicit binary_reader( std::string_view data ) : data( data ) {}
+
+        std::uint32_t read_varint();
+        std::int32_t read_zigzag();
+        std::string_view read_bytes( size_t count );
+
+        bool empty() const {
+            return data.empty();
+        }
+
+    private:
+        std::string_view data;
+};
+
+/**
+ * Maps indices used in binary quad files to the string ids of terrain, furniture and traps.
+ * There's one per world, so that quad files stay valid when int ids change, e.g. because
+ * the loaded mods changed.  It only ever grows.
+ */
+class submap_id_palette
+{
+    public:
+        std::uint32_t index_of( const ter_id &id );
+        std::uint32_t index_of( const furn_id &id );
+        std::uint32_t index_of( const trap_id &id );
+
+        // Throws std::runtime_error if the index is not in the palette
+        ter_id ter_at( std::uint32_t index );
+        furn_id furn_at( std::uint32_t index );
+        trap_id trap_at( std::uint32_t index );
+
+        /** Whether ids were added since the last call to @ref serialize. */
+        bool is_modified() const {
+            return modified;
+        }
+
+        void serialize( JsonOut &jsout );
+        void deserialize( JsonIn &jsin );
+
+    private:
+        template<typename T>
+        struct id_table {
+            std::vector<string_id<T>> ids;
+            // Resolved when added or loaded, empty for ids of objects that no longer exist, which
+            // only complain when a quad uses them
+            std::vector<std::optional<int_id<T>>> resolved;
+            std::unordered_map<int, std::uint32_t> indices;
+
+            std::uint32_t index_of( const int_id<T> &id, bool &modified );
+            int_id<T> at( std::uint32_t index );
+        };
+
+        id_table<ter_t> ter;
+        id_table<furn_t> furn;
+        id_table<trap> trp;
+        bool modified = false;
+};
+
+void write_binary_quad_header( std::string &out, std::uint32_t submap_count );
+void write_binary_submap( std::string &out, const tripoint &pos, const submap &sm,
+                          submap_id_palette &palette );
+
+/** @return number of submaps in the quad file. Throws std::runtime_error if it's not one. */
+std::uint32_t read_binary_quad_header( binary_reader &in );
+std::unique_ptr<submap> read_binary_submap( binary_reader &in, submap_id_palette &palette,
+        tripoint &pos );
+
+#endif // CATA_SRC_SUBMAP_BINARY_H
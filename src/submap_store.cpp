@@ -0,0 +1,116 @@
+#include "submap_store.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "submap.h"
+
+submap_store::submap_store() = default;
+submap_store::~submap_store() = default;
+
+size_t submap_store::home_slot( const tripoint &p ) const
+{
+    // Fibonacci hashing, so that the high bits of the hash pick the slot
+    constexpr std::uint64_t golden_ratio = 11400714819323198485ULL;
+    const std::uint64_t hash = std::hash<tripoint>()( p ) * golden_ratio;
+    return static_cast<size_t>( hash >> ( 64 - slot_bits ) );
+}
+
+size_t submap_store::find_slot( const tripoint &p ) const
+{
+    if( slots.empty() ) {
+        return no_slot;
+    }
+    const size_t mask = slots.size() - 1;
+    for( size_t slot = home_slot( p ); ; slot = ( slot + 1 ) & mask ) {
+        const std::int32_t index = slots[slot];
+        if( index == empty_slot ) {
+            return no_slot;
+        }
+        if( entries[index].first == p ) {
+            return slot;
+        }
+    }
+}
+
+submap *submap_store::find( const tripoint &p ) const
+{
+    const size_t slot = find_slot( p );
+    return slot == no_slot ? nullptr : entries[slots[slot]].second.get();
+}
+
+void submap_store::rehash( size_t slot_count )
+{
+    slots.assign( slot_count, empty_slot );
+    slot_bits = 0;
+    while( ( static_cast<size_t>( 1 ) << slot_bits ) < slot_count ) {
+        slot_bits++;
+    }
+    const size_t mask = slot_count - 1;
+    for( size_t index = 0; index < entries.size(); index++ ) {
+        size_t slot = home_slot( entries[index].first );
+        while( slots[slot] != empty_slot ) {
+            slot = ( slot + 1 ) & mask;
+        }
+        slots[slot] = static_cast<std::int32_t>( index );
+    }
+}
+
+bool submap_store::insert( const tripoint &p, std::unique_ptr<submap> &sm )
+{
+    if( contains( p ) ) {
+        return false;
+    }
+    // At most half full, so that probe sequences stay short
+    if( ( entries.size() + 1 ) * 2 > slots.size() ) {
+        rehash( std::max<size_t>( 64, slots.size() * 2 ) );
+    }
+    const size_t mask = slots.size() - 1;
+    size_t slot = home_slot( p );
+    while( slots[slot] != empty_slot ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    slots[slot] = static_cast<std::int32_t>( entries.size() );
+    entries.emplace_back( p, std::move( sm ) );
+    return true;
+}
+
+std::unique_ptr<submap> submap_store::erase( const tripoint &p )
+{
+    size_t slot = find_slot( p );
+    if( slot == no_slot ) {
+        return nullptr;
+    }
+    const std::int32_t index = slots[slot];
+    std::unique_ptr<submap> result = std::move( entries[index].second );
+
+    // Shift the following entries of the probe sequence back, so that there are no gaps in it
+    const size_t mask = slots.size() - 1;
+    for( size_t next = ( slot + 1 ) & mask; slots[next] != empty_slot; next = ( next + 1 ) & mask ) {
+        const size_t home = home_slot( entries[slots[next]].first );
+        // Whether the entry at next can be moved to slot without becoming unreachable
+        const bool movable = slot <= next ? ( home <= slot || home > next ) :
+                             ( home <= slot && home > next );
+        if( movable ) {
+            slots[slot] = slots[next];
+            slot = next;
+        }
+    }
+    slots[slot] = empty_slot;
+
+    // Fill the hole in entries with the last one
+    const std::int32_t last = static_cast<std::int32_t>( entries.size() - 1 );
+    if( index != last ) {
+        slots[find_slot( entries[last].first )] = index;
+        entries[index] = std::move( entries[last] );
+    }
+    entries.pop_back();
+    return result;
+}
+
+void submap_store::clear()
+{
+    entries.clear();
+    slots.clear();
+    slot_bits = 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#ifndef CATA_SRC_SUBMAP_STORE_H
+#define CATA_SRC_SUBMAP_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Owns submaps by their absolute position in submap coordinates.
+ *
+ * Submaps live in a dense vector, indexed by an open addressing hash table with linear probing.
+ * Lookups touch one or two cache lines instead of walking a tree, which matters with the
+ * tens of thousands of submaps that pile up in long games.
+ * Iteration order is arbitrary and changes when submaps are erased.
+ */
+class submap_store
+{
+    public:
+        using value_type = std::pair<tripoint, std::unique_ptr<submap>>;
+        using iterator = std::vector<value_type>::iterator;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        submap_store();
+        ~submap_store();
+
+        /** @return nullptr if there is no submap at p. */
+        submap *find( const tripoint &p ) const;
+        bool contains( const tripoint &p ) const {
+            return find_slot( p ) != no_slot;
+        }
+
+        /**
+         * Takes ownership of sm, unless there already is a submap at p.
+         * @return true if sm was stored.
+         */
+        bool insert( const tripoint &p, std::unique_ptr<submap> &sm );
+        /** @return The removed submap, nullptr if there was none. */
+        std::unique_ptr<submap> erase( const tripoint &p );
+        void clear();
+
+        size_t size() const {
+            return entries.size();
+        }
+        bool empty() const {
+            return entries.empty();
+        }
+
+        iterator begin() {
+            return entries.begin();
+        }
+        iterator end() {
+            return entries.end();
+        }
+        const_iterator begin() const {
+            return entries.begin();
+        }
+        const_iterator end() const {
+            return entries.end();
+        }
+
+    private:
+        static constexpr std::int32_t empty_slot = -1;
+        static constexpr size_t no_slot = static_cast<size_t>( -1 );
+
+        size_t home_slot( const tripoint &p ) const;
+        /** @return Slot holding the index of p, or no_slot. */
+        size_t find_slot( const tripoint &p ) const;
+        void rehash( size_t slot_count );
+
+        std::vector<value_type> entries;
+        // Indices into entries, the size is always a power of two
+        std::vector<std::int32_t> slots;
+        // Number of bits of the hash used to pick a slot
+        int slot_bits = 0;
+};
+
+#endif // CATA_SRC_SUBMAP_STORE_H
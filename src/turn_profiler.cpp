@@ -0,0 +1,226 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#include "json.h"
+
+namespace turn_profiler
+{
+
+namespace
+{
+
+struct zone_record {
+    const char *name = nullptr;
+    std::int64_t start = 0;
+    std::int64_t end = 0;
+    std::uint32_t thread = 0;
+};
+
+// Written seqlock style: `seq` is 0 while the slot is being written, then index + 1 of the zone
+struct zone_slot {
+    std::atomic<std::uint64_t> seq{ 0 };
+    std::atomic<const char *> name{ nullptr };
+    std::atomic<std::int64_t> start{ 0 };
+    std::atomic<std::int64_t> end{ 0 };
+    std::atomic<std::uint32_t> thread{ 0 };
+};
+
+constexpr std::uint64_t ring_size = 1 << 16;
+std::array<zone_slot, ring_size> ring;
+std::atomic<std::uint64_t> next_zone{ 0 };
+std::atomic<std::uint32_t> next_thread{ 0 };
+
+// Only touched by the main thread
+std::uint64_t read_index = 0;
+std::uint64_t trace_start = 0;
+std::int64_t last_turn_end = 0;
+std::vector<turn_summary> summaries;
+constexpr size_t max_summaries = 50;
+
+constexpr const char *turn_zone = "turn";
+
+std::uint32_t thread_index()
+{
+    thread_local const std::uint32_t index = next_thread++;
+    return index;
+}
+
+bool read_zone( std::uint64_t index, zone_record &out )
+{
+    const zone_slot &slot = ring[index % ring_size];
+    const std::uint64_t seq = slot.seq.load( std::memory_order_acquire );
+    if( seq != index + 1 ) {
+        return false;
+    }
+    out.name = slot.name.load( std::memory_order_relaxed );
+    out.start = slot.start.load( std::memory_order_relaxed );
+    out.end = slot.end.load( std::memory_order_relaxed );
+    out.thread = slot.thread.load( std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_acquire );
+    // Overwritten while it was being read
+    return slot.seq.load( std::memory_order_relaxed ) == seq;
+}
+
+void add_to( std::vector<zone_total> &totals, const char *name, std::int64_t ns, int calls )
+{
+    // The same literal may have a different address in each translation unit
+    const auto it = std::find_if( totals.begin(), totals.end(), [name]( const zone_total & t ) {
+        return t.name == name || std::strcmp( t.name, name ) == 0;
+    } );
+    if( it == totals.end() ) {
+        totals.push_back( zone_total{ name, ns, calls } );
+    } else {
+        it->ns += ns;
+        it->calls += calls;
+    }
+}
+
+void sort_by_time( std::vector<zone_total> &totals )
+{
+    std::sort( totals.begin(), totals.end(), []( const zone_total & l, const zone_total & r ) {
+        return l.ns > r.ns;
+    } );
+}
+
+} // namespace
+
+namespace detail
+{
+
+std::atomic<bool> enabled{ false };
+
+std::int64_t now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch ).count() + 1;
+}
+
+void record( const char *name, std::int64_t start, std::int64_t end )
+{
+    const std::uint64_t index = next_zone.fetch_add( 1, std::memory_order_relaxed );
+    zone_slot &slot = ring[index % ring_size];
+    slot.seq.store( 0, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+    slot.name.store( name, std::memory_order_relaxed );
+    slot.start.store( start, std::memory_order_relaxed );
+    slot.end.store( end, std::memory_order_relaxed );
+    slot.thread.store( thread_index(), std::memory_order_relaxed );
+    slot.seq.store( index + 1, std::memory_order_release );
+}
+
+} // namespace detail
+
+bool is_enabled()
+{
+    return detail::enabled.load( std::memory_order_relaxed );
+}
+
+void set_enabled( bool enabled )
+{
+    if( enabled && !is_enabled() ) {
+        // Time spent while it was off doesn't belong to the next turn
+        read_index = next_zone.load( std::memory_order_acquire );
+        last_turn_end = 0;
+    }
+    detail::enabled.store( enabled, std::memory_order_relaxed );
+}
+
+void end_turn( const time_point &turn )
+{
+    if( !is_enabled() ) {
+        return;
+    }
+    const std::int64_t now = detail::now();
+    turn_summary summary;
+    summary.turn = turn;
+    if( last_turn_end != 0 ) {
+        detail::record( turn_zone, last_turn_end, now );
+        summary.frame_ns = now - last_turn_end;
+    }
+    last_turn_end = now;
+
+    const std::uint64_t end = next_zone.load( std::memory_order_acquire );
+    if( end - read_index > ring_size ) {
+        summary.dropped += static_cast<int>( end - read_index - ring_size );
+        read_index = end - ring_size;
+    }
+    for( ; read_index < end; read_index++ ) {
+        zone_record zone;
+        if( !read_zone( read_index, zone ) ) {
+            summary.dropped++;
+        } else if( zone.name != turn_zone ) {
+            add_to( summary.zones, zone.name, zone.end - zone.start, 1 );
+        }
+    }
+    sort_by_time( summary.zones );
+
+    if( summaries.size() == max_summaries ) {
+        summaries.erase( summaries.begin() );
+    }
+    summaries.push_back( std::move( summary ) );
+}
+
+const std::vector<turn_summary> &recent_turns()
+{
+    return summaries;
+}
+
+std::vector<zone_total> average_turn()
+{
+    std::vector<zone_total> result;
+    for( const turn_summary &summary : summaries ) {
+        for( const zone_total &zone : summary.zones ) {
+            add_to( result, zone.name, zone.ns, zone.calls );
+        }
+    }
+    for( zone_total &zone : result ) {
+        zone.ns /= static_cast<std::int64_t>( summaries.size() );
+    }
+    sort_by_time( result );
+    return result;
+}
+
+void write_chrome_trace( std::ostream &out )
+{
+    const std::uint64_t end = next_zone.load( std::memory_order_acquire );
+    const std::uint64_t begin = std::max( trace_start, end > ring_size ? end - ring_size : 0 );
+    JsonOut jsout( out );
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    for( std::uint64_t i = begin; i < end; i++ ) {
+        zone_record zone;
+        if( !read_zone( i, zone ) ) {
+            continue;
+        }
+        jsout.start_object();
+        jsout.member( "name", std::string( zone.name ) );
+        jsout.member( "ph", "X" );
+        // Microseconds
+        jsout.member( "ts", zone.start / 1000.0 );
+        jsout.member( "dur", ( zone.end - zone.start ) / 1000.0 );
+        jsout.member( "pid", 0 );
+        jsout.member( "tid", zone.thread );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+void clear()
+{
+    trace_start = next_zone.load( std::memory_order_acquire );
+    read_index = trace_start;
+    last_turn_end = 0;
+    summaries.clear();
+}
+
+} // namespace turn_profiler
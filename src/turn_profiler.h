@@ -0,0 +1,91 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "calendar.h"
+
+/**
+ * Built-in profiler for finding out what makes turns slow, without building with Tracy.
+ *
+ * Zones are recorded into a lock-free ring buffer, so they can be recorded from any thread.
+ * At the end of each turn the zones recorded during it are added up per name, those sums
+ * are shown in the "Turn Profile" sidebar panel.  What's left in the ring buffer can be
+ * written out in the Chrome trace format, which chrome://tracing and Perfetto can open.
+ *
+ * Recording is off until it's turned on from the debug menu.  While it's off, a zone
+ * costs a single relaxed load.
+ */
+namespace turn_profiler
+{
+
+bool is_enabled();
+void set_enabled( bool enabled );
+
+namespace detail
+{
+extern std::atomic<bool> enabled;
+// Nanoseconds since the profiler was first used, never 0
+std::int64_t now();
+void record( const char *name, std::int64_t start, std::int64_t end );
+} // namespace detail
+
+/** Records the time spent in its scope under @p name, which has to be a string literal. */
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( const char *name ) : name( name ),
+            start( detail::enabled.load( std::memory_order_relaxed ) ? detail::now() : 0 ) {}
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+        ~scoped_zone() {
+            if( start != 0 ) {
+                detail::record( name, start, detail::now() );
+            }
+        }
+
+    private:
+        const char *name;
+        std::int64_t start;
+};
+
+struct zone_total {
+    const char *name = nullptr;
+    std::int64_t ns = 0;
+    int calls = 0;
+};
+
+struct turn_summary {
+    time_point turn;
+    // Wall time since the end of the previous turn, including waiting for input
+    std::int64_t frame_ns = 0;
+    // Ordered by time spent, most first
+    std::vector<zone_total> zones;
+    // Zones that were overwritten in the ring buffer before they could be added up
+    int dropped = 0;
+};
+
+/**
+ * Adds up the zones recorded since the last call into a summary of @p turn.
+ * Called by the main thread at the end of each turn, does nothing when not recording.
+ */
+void end_turn( const time_point &turn );
+/** Summaries of the last turns, oldest first. */
+const std::vector<turn_summary> &recent_turns();
+/** Zone sums averaged over @ref recent_turns, ordered by time spent. */
+std::vector<zone_total> average_turn();
+
+/** Writes the zones still in the ring buffer as Chrome trace JSON. */
+void write_chrome_trace( std::ostream &out );
+/** Forgets all recorded zones and summaries. */
+void clear();
+
+} // namespace turn_profiler
+
+#define CATA_TURN_ZONE( name ) turn_profiler::scoped_zone turn_profiler_zone_( name )
+
+#endif // CATA_SRC_TURN_PROFILER_H
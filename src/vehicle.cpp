@@ -5628,6 +5628,7 @@ detached_ptr<item> vehicle::add_item( int part, detached_ptr<item> &&itm )
     p.items.push_back( std::move( itm ) );
 
     invalidate_mass();
+    get_map().mark_contents_changed();
     return detached_ptr<item>();
 }
 
@@ -5656,6 +5657,7 @@ vehicle_stack::iterator vehicle::remove_item( int part, vehicle_stack::const_ite
 
     vehicle_stack::iterator iter = parts[part].items.erase( std::move( it ), ret );
     invalidate_mass();
+    get_map().mark_contents_changed();
     return iter;
 }
 
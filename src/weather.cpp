@@ -1155,6 +1155,7 @@ auto weather_manager::get_water_temperature( const tripoint & ) const -> units::
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    rot_catchup_cache.clear();
 }
 
 namespace weather
@@ -5,6 +5,7 @@
 #include "calendar.h"
 #include "color.h"
 #include "coordinates.h"
+#include "hash_utils.h"
 #include "pimpl.h"
 #include "point.h"
 #include "type_id.h"
@@ -13,6 +14,7 @@
 
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -213,6 +215,16 @@ class weather_manager
         auto get_water_temperature( const tripoint &location ) const -> units::temperature;
         void clear_temp_cache();
 
+        /**
+         * Rot accumulated by items left outside of the reality bubble, hour by hour, cleared every turn.
+         * Keyed by absolute location, turn of the first hour, local temperature modifier in
+         * millidegrees, temperature flag and rot factor.  Element i is the rot after i hours.
+         * Filled and used by @ref item::process_rot.
+         */
+        using rot_catchup_key = std::tuple<tripoint, int, int, int, float>;
+        mutable std::unordered_map<rot_catchup_key, std::vector<time_duration>, cata::tuple_hash>
+        rot_catchup_cache;
+
         // Get precise weather data
         const w_point &get_precise() const {
             return weather_precise;
@@ -0,0 +1,20 @@
+#include "bench_helpers.h"
+
+#include <string>
+
+std::map<std::string, std::string> bench_config;
+
+int get_bench_config( const std::string &name, int default_value )
+{
+    const auto it = bench_config.find( name );
+    if( it == bench_config.end() || it->second.empty() ) {
+        return default_value;
+    }
+    return std::stoi( it->second );
+}
+
+std::string get_bench_config( const std::string &name, const std::string &default_value )
+{
+    const auto it = bench_config.find( name );
+    return it == bench_config.end() ? default_value : it->second;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#ifndef CATA_TESTS_BENCH_HELPERS_H
+#define CATA_TESTS_BENCH_HELPERS_H
+
+#include <map>
+#include <string>
+
+/** Name-value pairs given to cata_test with --bench_config=n:v[,…] */
+extern std::map<std::string, std::string> bench_config;
+
+int get_bench_config( const std::string &name, int default_value );
+std::string get_bench_config( const std::string &name, const std::string &default_value );
+
+#endif // CATA_TESTS_BENCH_HELPERS_H
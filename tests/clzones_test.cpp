@@ -0,0 +1,57 @@
+#include "catch/catch.hpp"
+
+#include <optional>
+#include <sstream>
+
+#include "cata_utility.h"
+#include "clzones.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "memory_fast.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const faction_id your_followers( "your_followers" );
+static const zone_type_id zone_LOOT_CUSTOM( "LOOT_CUSTOM" );
+static const zone_type_id zone_LOOT_FOOD( "LOOT_FOOD" );
+
+static shared_ptr_fast<zone_options> custom_loot_filter( const std::string &filter )
+{
+    shared_ptr_fast<zone_options> options = zone_options::create( zone_LOOT_CUSTOM );
+    std::istringstream is( "{\"mark\":\"" + filter + "\"}" );
+    JsonIn jsin( is );
+    options->deserialize( jsin.get_object() );
+    return options;
+}
+
+TEST_CASE( "zones_near_a_point_are_found_from_their_areas", "[zone]" )
+{
+    clear_all_state();
+    zone_manager::reset_manager();
+    on_out_of_scope reset_zones( []() {
+        zone_manager::reset_manager();
+    } );
+    zone_manager &zmgr = zone_manager::get_manager();
+    const tripoint origin = get_map().getabs( tripoint( 60, 60, 0 ) );
+
+    zmgr.add( "food", zone_LOOT_FOOD, your_followers, false, true,
+              origin + tripoint( 5, 0, 0 ), origin + tripoint( 7, 2, 0 ) );
+    CHECK( zmgr.has( zone_LOOT_FOOD, origin + tripoint( 6, 1, 0 ) ) );
+    CHECK( zmgr.has_near( zone_LOOT_FOOD, origin, 5 ) );
+    CHECK_FALSE( zmgr.has_near( zone_LOOT_FOOD, origin, 4 ) );
+    CHECK_FALSE( zmgr.has_near( zone_LOOT_FOOD, origin + tripoint_above, 10 ) );
+    CHECK( zmgr.get_nearest( zone_LOOT_FOOD, origin, 10 ) == origin + tripoint( 5, 0, 0 ) );
+    CHECK( zmgr.get_nearest( zone_LOOT_FOOD, origin, 4 ) == std::nullopt );
+    // Only the two columns of the zone within range
+    CHECK( zmgr.get_near( zone_LOOT_FOOD, origin, 6 ).size() == 6 );
+
+    zmgr.add( "apples", zone_LOOT_CUSTOM, your_followers, false, true,
+              origin - tripoint( 3, 3, 0 ), origin - tripoint( 2, 2, 0 ), custom_loot_filter( "apple" ) );
+    item &apple = *item::spawn_temporary( "apple" );
+    item &rock = *item::spawn_temporary( "rock" );
+    CHECK( zmgr.get_near( zone_LOOT_CUSTOM, origin, 10, &apple ).size() == 4 );
+    CHECK( zmgr.get_near( zone_LOOT_CUSTOM, origin, 10, &rock ).empty() );
+    CHECK( zmgr.get_near_zone_type_for_item( apple, origin, 10 ) == zone_LOOT_CUSTOM );
+}
@@ -778,3 +778,67 @@ TEST_CASE( "tool selection ui", "[crafting][ui]" )
         }
     }
 }
+
+TEST_CASE( "crafting_map_inventory_is_kept_until_the_map_changes", "[crafting][inventory]" )
+{
+    clear_all_state();
+    avatar &u = get_avatar();
+    const tripoint test_origin( 60, 60, 0 );
+    u.setpos( test_origin );
+    map &here = get_map();
+    here.add_item( test_origin + tripoint_east, item::spawn( "hammer" ) );
+
+    const inventory &map_inv = u.crafting_map_inventory();
+    CHECK( map_inv.amount_of( itype_id( "hammer" ) ) == 1 );
+    const int revision = here.get_contents_revision();
+    CHECK( u.crafting_map_inventory().amount_of( itype_id( "hammer" ) ) == 1 );
+    CHECK( here.get_contents_revision() == revision );
+
+    // Moving on within the turn doesn't lose it, changing the map does
+    u.moves -= 100;
+    here.add_item( test_origin + tripoint_west, item::spawn( "hammer" ) );
+    CHECK( here.get_contents_revision() != revision );
+    CHECK( u.crafting_inventory().amount_of( itype_id( "hammer" ) ) == 2 );
+    here.i_clear( test_origin + tripoint_east );
+    CHECK( u.crafting_map_inventory().amount_of( itype_id( "hammer" ) ) == 1 );
+    CHECK( u.crafting_inventory().amount_of( itype_id( "hammer" ) ) == 1 );
+}
+
+TEST_CASE( "recipes_are_only_ruled_out_if_they_cant_be_made", "[crafting][recipes]" )
+{
+    clear_all_state();
+    avatar &u = get_avatar();
+    u.setpos( tripoint( 60, 60, 0 ) );
+    u.wear_item( item::spawn( "backpack" ), false );
+    for( const char *type : { "hammer", "pockknife", "rock", "stick_long", "rag" } ) {
+        u.i_add( item::spawn( type ) );
+    }
+    u.i_add( item::spawn( "nail", calendar::start_of_cataclysm, 20 ) );
+    const inventory &crafting_inv = u.crafting_inventory();
+
+    std::vector<const recipe *> recipes;
+    std::vector<const requirement_data *> reqs;
+    for( const auto &pr : recipe_dict ) {
+        recipes.push_back( &pr.second );
+        reqs.push_back( &pr.second.simple_requirements() );
+    }
+    const std::vector<bool> could_make = requirement_data::could_make_with_inventory(
+            reqs, crafting_inv, 1, cost_adjustment::start_only );
+    REQUIRE( could_make.size() == reqs.size() );
+
+    int ruled_out = 0;
+    for( size_t i = 0; i < recipes.size(); i++ ) {
+        const bool can_make = reqs[i]->can_make_with_inventory( crafting_inv,
+                              recipes[i]->get_component_filter(), 1, cost_adjustment::start_only );
+        if( can_make ) {
+            CAPTURE( recipes[i]->ident().str() );
+            CHECK( could_make[i] );
+        }
+        if( !could_make[i] ) {
+            ruled_out++;
+        }
+    }
+    // Most recipes need something not at hand
+    CHECK( ruled_out > static_cast<int>( recipes.size() ) / 2 );
+    CHECK( std::count( could_make.begin(), could_make.end(), true ) > 0 );
+}
@@ -0,0 +1,94 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static std::vector<monster *> brute_force_in_radius( const tripoint &center, int radius,
+        int radiusz )
+{
+    std::vector<monster *> result;
+    for( monster &critter : g->all_monsters() ) {
+        const tripoint &p = critter.pos();
+        if( std::abs( p.x - center.x ) <= radius && std::abs( p.y - center.y ) <= radius &&
+            std::abs( p.z - center.z ) <= radiusz ) {
+            result.push_back( &critter );
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+static std::vector<monster *> sorted( std::vector<monster *> monsters )
+{
+    std::sort( monsters.begin(), monsters.end() );
+    return monsters;
+}
+
+TEST_CASE( "creature_tracker_radius_queries_match_brute_force", "[creature_tracker]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    Creature_tracker &tracker = *g->critter_tracker;
+
+    std::vector<monster *> spawned;
+    for( int x = 5; x < MAPSIZE_X; x += 13 ) {
+        for( int y = 7; y < MAPSIZE_Y; y += 11 ) {
+            spawned.push_back( &spawn_test_monster( "mon_zombie", tripoint( x, y, 0 ) ) );
+        }
+    }
+    REQUIRE( tracker.size() == spawned.size() );
+
+    const std::vector<tripoint> centers = { { 0, 0, 0 }, { 60, 60, 0 }, { 130, 2, 0 }, { 33, 100, 0 } };
+    for( const tripoint &center : centers ) {
+        for( int radius : { 0, 5, 12, 30, 200 } ) {
+            CAPTURE( center, radius );
+            CHECK( sorted( tracker.find_in_radius( center, radius ) ) ==
+                   brute_force_in_radius( center, radius, 0 ) );
+        }
+    }
+
+    SECTION( "moved monsters are found at their new position" ) {
+        monster &moved = *spawned.front();
+        const tripoint destination( 100, 100, 0 );
+        REQUIRE( moved.pos() != destination );
+        moved.setpos( destination );
+        CHECK( tracker.find_in_radius( destination, 0 ) == std::vector<monster *> { &moved } );
+        CHECK( sorted( tracker.find_in_radius( tripoint( 60, 60, 0 ), 60 ) ) ==
+               brute_force_in_radius( tripoint( 60, 60, 0 ), 60, 0 ) );
+    }
+
+    SECTION( "dead monsters are not found" ) {
+        monster &dead = *spawned.front();
+        dead.die( nullptr );
+        const std::vector<monster *> found = tracker.find_in_radius( dead.pos(), 200 );
+        CHECK( std::find( found.begin(), found.end(), &dead ) == found.end() );
+    }
+
+    SECTION( "nearest monsters come first" ) {
+        const tripoint center( 50, 50, 0 );
+        const std::vector<monster *> nearest = tracker.find_nearest( center, 3, 200 );
+        REQUIRE( nearest.size() == 3 );
+        int furthest_found = 0;
+        for( const monster *critter : nearest ) {
+            const int dist = rl_dist( center, critter->pos() );
+            CHECK( dist >= furthest_found );
+            furthest_found = dist;
+        }
+        for( const monster &critter : g->all_monsters() ) {
+            if( std::find( nearest.begin(), nearest.end(), &critter ) == nearest.end() ) {
+                CHECK( rl_dist( center, critter.pos() ) >= furthest_found );
+            }
+        }
+        CHECK( tracker.find_nearest( center, 3, 1 ).empty() );
+    }
+}
@@ -0,0 +1,180 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_utility.h"
+#include "data_snapshot.h"
+#include "distribution_grid.h"
+#include "filesystem.h"
+#include "game.h"
+#include "init.h"
+#include "item_factory.h"
+#include "itype.h"
+#include "json.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "mapdata.h"
+#include "mod_manager.h"
+#include "monstergenerator.h"
+#include "mtype.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "recipe.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "type_id.h"
+#include "veh_type.h"
+#include "worldfactory.h"
+
+// Types and ids of the objects in a data file, in order
+static std::vector<std::pair<std::string, std::string>> objects_in( const std::string &contents,
+        const std::string &file )
+{
+    std::vector<std::pair<std::string, std::string>> result;
+    std::istringstream iss( contents );
+    JsonIn jsin( iss, file );
+    const auto add = [&]( const JsonObject & jo ) {
+        jo.allow_omitted_members();
+        result.emplace_back( jo.get_string( "type", "" ), jo.has_string( "id" ) ? jo.get_string( "id" ) : "" );
+    };
+    if( jsin.test_object() ) {
+        add( jsin.get_object() );
+    } else {
+        for( JsonObject jo : jsin.get_array() ) {
+            add( jo );
+        }
+    }
+    return result;
+}
+
+// Some of the loaded data, including data filled in by the consistency checks
+static std::vector<std::string> loaded_data()
+{
+    std::vector<std::string> result;
+    for( const itype *type : item_controller->all() ) {
+        result.push_back( string_format( "item %s %d %d", type->get_id().str(),
+                                         to_gram( type->weight ), to_milliliter( type->volume ) ) );
+    }
+    for( const auto &vp : vpart_info::all() ) {
+        std::string components;
+        const requirement_data install = vp.second.install_requirements();
+        for( const std::vector<item_comp> &alternatives : install.get_components() ) {
+            for( const item_comp &comp : alternatives ) {
+                components += string_format( " %s:%d", comp.type.str(), comp.count );
+            }
+        }
+        result.push_back( string_format( "vpart %s %d %s%s", vp.first.str(), vp.second.removal_moves,
+                                         vp.second.fuel_type.str(), components ) );
+    }
+    for( const mtype &type : MonsterGenerator::generator().get_all_mtypes() ) {
+        result.push_back( string_format( "monster %s %d %d", type.id.str(), type.hp, type.speed ) );
+    }
+    for( const auto &r : recipe_dict ) {
+        result.push_back( string_format( "recipe %s %s", r.first.str(), r.second.result().str() ) );
+    }
+    for( const ter_t &ter : ter_t::get_all() ) {
+        result.push_back( "terrain " + ter.id.str() );
+    }
+    for( const furn_t &furn : furn_t::get_all() ) {
+        result.push_back( "furniture " + furn.id.str() );
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+// Snapshots are written to a directory of their own, which is removed afterwards
+struct temp_data_cache_dir {
+    std::string old_dir = PATH_INFO::data_cache_dir();
+    std::string dir = ( std::filesystem::temp_directory_path() / ( "cata_data_snapshot_test_" +
+                        get_pid_string() ) ).generic_string() + "/";
+
+    temp_data_cache_dir() {
+        PATH_INFO::set_data_cache_dir( dir );
+    }
+    ~temp_data_cache_dir() {
+        PATH_INFO::set_data_cache_dir( old_dir );
+        remove_tree( dir );
+    }
+};
+
+TEST_CASE( "data_snapshot_matches_data_files", "[init]" )
+{
+    temp_data_cache_dir cache_dir;
+    const mod_id core = mod_management::get_default_core_content_pack();
+    data_snapshot( { core } ).save();
+    const std::string snapshot_file = cache_dir.dir + "data-" + data_snapshot( { core } ).get_key() +
+                                      ".bin";
+    REQUIRE( file_exist( snapshot_file ) );
+
+    data_snapshot snapshot( { core } );
+    REQUIRE( snapshot.load() );
+
+    const std::vector<std::string> files = DynamicDataLoader::get_data_files( core->path );
+    CHECK( snapshot.files_in( core->path ) == files );
+    CHECK( snapshot.file_count() == files.size() );
+    int objects = 0;
+    for( const std::string &file : files ) {
+        CAPTURE( file );
+        const std::string *contents = snapshot.contents_of( file );
+        REQUIRE( contents != nullptr );
+        const auto from_snapshot = objects_in( *contents, file );
+        CHECK( from_snapshot == objects_in( read_entire_file( file ), file ) );
+        objects += from_snapshot.size();
+    }
+    CHECK( objects > 1000 );
+
+    SECTION( "snapshots can be ignored" ) {
+        rebuild_data_snapshot = true;
+        data_snapshot ignored( { core } );
+        CHECK_FALSE( ignored.load() );
+        CHECK( ignored.contents_of( files.front() ) == nullptr );
+        CHECK( ignored.files_in( core->path ) == files );
+        rebuild_data_snapshot = false;
+    }
+}
+
+TEST_CASE( "data_loaded_from_snapshot_matches_data_loaded_from_files", "[init]" )
+{
+    // Nothing may refer to the item types that are about to be reloaded
+    clear_all_state();
+    // The overmaps, the avatar, the map and the grids refer to the data that is replaced, so
+    // they're made again after, like when the tests start
+    on_out_of_scope reload_map( []() {
+        overmap_buffer.clear();
+        g->u = avatar();
+        g->u.create( character_type::NOW );
+        g->m = map();
+        g->m.load( tripoint( g->get_levx(), g->get_levy(), g->get_levz() ), false );
+        get_distribution_grid_tracker().load( g->m );
+    } );
+    loading_ui ui( false );
+    const std::string artifacts = g->get_world_base_save_path() + "/" + SAVE_ARTIFACTS;
+    // Loaded again, without the placeholder types that earlier tests made for unknown ids
+    init::load_world_modfiles( ui, artifacts );
+    const std::vector<std::string> from_files = loaded_data();
+    REQUIRE( from_files.size() > 1000 );
+
+    temp_data_cache_dir cache_dir;
+    const std::vector<mod_id> &mods = world_generator->active_world->active_mod_order;
+    data_snapshot( mods ).save();
+    REQUIRE( data_snapshot( mods ).load() );
+
+    use_data_snapshot_in_tests = true;
+    init::load_world_modfiles( ui, artifacts );
+    use_data_snapshot_in_tests = false;
+
+    const std::vector<std::string> from_snapshot = loaded_data();
+    CHECK( from_snapshot.size() == from_files.size() );
+    const auto mismatch = std::mismatch( from_files.begin(), from_files.end(), from_snapshot.begin(),
+                                         from_snapshot.end() );
+    CHECK( ( mismatch.first == from_files.end() ? std::string() : *mismatch.first ) ==
+           ( mismatch.second == from_snapshot.end() ? std::string() : *mismatch.second ) );
+}
@@ -2,11 +2,16 @@
 
 #include <list>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "bodypart.h"
 #include "json.h"
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "filesystem.h"
+#include "game.h"
+#include "path_info.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
@@ -252,6 +257,8 @@ static void test_get_string( const std::string &str, const std::string &json )
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK( jsin.get_string() == str );
+    JsonIn jsin_memory( json );
+    CHECK( jsin_memory.get_string() == str );
 }
 
 template<typename Matcher>
@@ -261,6 +268,8 @@ static void test_get_string_throws_matches( Matcher &&matcher, const std::string
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    JsonIn jsin_memory( json );
+    CHECK_THROWS_MATCHES( jsin_memory.get_string(), JsonError, matcher );
 }
 
 template<typename Matcher>
@@ -272,6 +281,8 @@ static void test_string_error_throws_matches( Matcher &&matcher, const std::stri
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    JsonIn jsin_memory( json );
+    CHECK_THROWS_MATCHES( jsin_memory.string_error( "<message>", offset ), JsonError, matcher );
 }
 
 TEST_CASE( "jsonin_get_string", "[json]" )
@@ -481,3 +492,126 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+// Reads everything in the value, so that the results of both ways of reading can be compared
+static void describe_json( JsonIn &jsin, std::string &out )
+{
+    out += std::to_string( jsin.tell() ) + ' ';
+    if( jsin.test_object() ) {
+        out += '{';
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            out += jsin.get_member_name() + ':';
+            describe_json( jsin, out );
+        }
+        out += '}';
+    } else if( jsin.test_array() ) {
+        out += '[';
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            describe_json( jsin, out );
+        }
+        out += ']';
+    } else if( jsin.test_string() ) {
+        out += '"' + jsin.get_string() + '"';
+    } else if( jsin.test_number() ) {
+        out += std::to_string( jsin.get_float() );
+    } else {
+        jsin.skip_value();
+    }
+    out += ',';
+}
+
+static std::string describe_json( JsonIn &jsin )
+{
+    std::string out;
+    try {
+        describe_json( jsin, out );
+        jsin.eat_whitespace();
+        out += jsin.good() ? "more" : "end";
+    } catch( const JsonError &err ) {
+        out += err.what();
+    }
+    return out;
+}
+
+TEST_CASE( "jsonin_reads_memory_same_as_stream", "[json]" )
+{
+    restore_on_out_of_scope<error_log_format_t> restore_error_log_format( error_log_format );
+    error_log_format = error_log_format_t::human_readable;
+
+    const std::string json = GENERATE( as<std::string>(),
+                                       R"({ "a": 1, "b": [ 2, "c", -3.5e2 ], "d": { "e": null } })",
+                                       R"([ "plain", "esc\"aped", "\u2026", "…", 12 ])",
+                                       "  [ 1 , 2 ]  ",
+                                       "7",
+                                       R"({ "a": 1 "b": 2 })",
+                                       R"([ 1, 2, ])",
+                                       R"([ "unterminated )",
+                                       "[ \"line\nbreak\" ]",
+                                       R"({ "a": tru })" );
+    CAPTURE( json );
+    std::istringstream iss( json );
+    JsonIn jsin( iss );
+    JsonIn jsin_memory( json );
+    CHECK( describe_json( jsin_memory ) == describe_json( jsin ) );
+}
+
+// Reads every value, the way loading data and saves does
+static int read_values( JsonIn &jsin )
+{
+    int count = 1;
+    if( jsin.test_object() ) {
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            jsin.get_member_name();
+            count += read_values( jsin );
+        }
+    } else if( jsin.test_array() ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            count += read_values( jsin );
+        }
+    } else if( jsin.test_string() ) {
+        jsin.get_string();
+    } else if( jsin.test_number() ) {
+        jsin.get_float();
+    } else {
+        jsin.skip_value();
+    }
+    return count;
+}
+
+TEST_CASE( "jsonin_benchmark", "[.][benchmark][json]" )
+{
+    // The game data, and the save of the test game
+    std::vector<std::string> files;
+    for( const std::string &file : get_files_from_path( ".json", PATH_INFO::datadir() + "json", true,
+            true ) ) {
+        files.push_back( read_entire_file( file ) );
+    }
+    REQUIRE( files.size() > 100 );
+    std::ostringstream save;
+    g->serialize( save );
+    // Without the version header
+    const std::string save_contents = save.str();
+    files.push_back( save_contents.substr( save_contents.find( '\n' ) + 1 ) );
+
+    BENCHMARK( "stream" ) {
+        int values = 0;
+        for( const std::string &json : files ) {
+            std::istringstream iss( json );
+            JsonIn jsin( iss );
+            values += read_values( jsin );
+        }
+        return values;
+    };
+    BENCHMARK( "memory" ) {
+        int values = 0;
+        for( const std::string &json : files ) {
+            JsonIn jsin( json );
+            values += read_values( jsin );
+        }
+        return values;
+    };
+}
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "shadowcasting.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+struct lightmap_copy {
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
+};
+
+static std::unique_ptr<lightmap_copy> build_lightmap( map &here, const std::string &mode )
+{
+    override_option lightmap_mode( "LIGHTMAP_MODE", mode );
+    here.build_map_cache( 0 );
+    const level_cache &cache = here.get_cache_ref( 0 );
+    auto result = std::make_unique<lightmap_copy>();
+    std::memcpy( result->lm, cache.lm, sizeof( cache.lm ) );
+    std::memcpy( result->sm, cache.sm, sizeof( cache.sm ) );
+    return result;
+}
+
+static void check_same_lightmap( const lightmap_copy &full, const lightmap_copy &incremental )
+{
+    int differences = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( full.lm[x][y].values != incremental.lm[x][y].values ||
+                full.sm[x][y] != incremental.sm[x][y] ) {
+                differences++;
+            }
+        }
+    }
+    CHECK( differences == 0 );
+}
+
+TEST_CASE( "incremental_lightmap_matches_full_rebuild", "[lightmap][shadowcasting]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+
+    const ter_id t_console( "t_console" );
+    const std::array<tripoint, 4> lights = { {
+            { 30, 30, 0 }, { 80, 30, 0 }, { 30, 90, 0 }, { 90, 90, 0 }
+        }
+    };
+    for( const tripoint &p : lights ) {
+        here.ter_set( p, t_console );
+    }
+    here.invalidate_map_cache( 0 );
+
+    check_same_lightmap( *build_lightmap( here, "full" ), *build_lightmap( here, "incremental" ) );
+    const light_source_cache *sources = here.get_light_source_cache( 0 );
+    REQUIRE( sources != nullptr );
+
+    // Nothing changed, so nothing is recast
+    check_same_lightmap( *build_lightmap( here, "full" ), *build_lightmap( here, "incremental" ) );
+    CHECK( sources->recast == 0 );
+    CHECK( sources->reused == static_cast<int>( lights.size() ) );
+
+    SECTION( "wall next to a light only recasts that light" ) {
+        here.ter_set( lights[0] + point_east * 2, ter_id( "t_wall" ) );
+        const std::unique_ptr<lightmap_copy> incremental = build_lightmap( here, "incremental" );
+        CHECK( sources->recast == 1 );
+        CHECK( sources->reused == static_cast<int>( lights.size() ) - 1 );
+        check_same_lightmap( *build_lightmap( here, "full" ), *incremental );
+    }
+
+    SECTION( "removed light is removed from the lightmap" ) {
+        here.ter_set( lights[1], ter_id( "t_floor" ) );
+        const std::unique_ptr<lightmap_copy> incremental = build_lightmap( here, "incremental" );
+        CHECK( sources->reused == static_cast<int>( lights.size() ) - 1 );
+        check_same_lightmap( *build_lightmap( here, "full" ), *incremental );
+    }
+}
@@ -0,0 +1,132 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static void check_route_is_walkable( const map &here, const std::vector<tripoint> &route,
+                                     const tripoint &from, const tripoint &to )
+{
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        CHECK( rl_dist( prev, p ) == 1 );
+        CHECK( here.passable( p ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "map_route_reuses_search_state", "[pathfinding]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+
+    // A wall with a single gap forces the route away from a straight line
+    const ter_id wall( "t_wall" );
+    const int wall_x = 60;
+    const int gap_y = 70;
+    for( int y = 50; y <= 80; y++ ) {
+        if( y != gap_y ) {
+            here.ter_set( tripoint( wall_x, y, 0 ), wall );
+        }
+    }
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+
+    const tripoint from( 55, 60, 0 );
+    const tripoint to( 65, 60, 0 );
+    pathfinding_settings settings;
+    settings.max_dist = 60;
+    settings.max_length = 120;
+
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    check_route_is_walkable( here, first, from, to );
+    CHECK( std::find( first.begin(), first.end(), tripoint( wall_x, gap_y, 0 ) ) != first.end() );
+
+    SECTION( "repeated requests give the same route" ) {
+        CHECK( here.route( from, to, settings ) == first );
+    }
+
+    SECTION( "aborted search does not leak into the next one" ) {
+        pathfinding_settings too_short = settings;
+        too_short.max_length = 5;
+        CHECK( here.route( from, to, too_short ).empty() );
+        CHECK( here.route( from, to, settings ) == first );
+    }
+
+    SECTION( "pre-closed tiles do not leak into the next search" ) {
+        const std::set<tripoint> closed_gap = { tripoint( wall_x, gap_y, 0 ) };
+        const std::vector<tripoint> detour = here.route( from, to, settings, closed_gap );
+        check_route_is_walkable( here, detour, from, to );
+        CHECK( std::find( detour.begin(), detour.end(), tripoint( wall_x, gap_y, 0 ) ) == detour.end() );
+        CHECK( here.route( from, to, settings ) == first );
+    }
+}
+
+static int route_cost( const tripoint &from, const std::vector<tripoint> &route )
+{
+    // Only valid on flat ground, where every step costs 2 plus 1 for diagonals
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        cost += 2 + ( ( p.x != prev.x && p.y != prev.y ) ? 1 : 0 );
+        prev = p;
+    }
+    return cost;
+}
+
+TEST_CASE( "map_route_shared_matches_route", "[pathfinding]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+
+    const ter_id wall( "t_wall" );
+    const int wall_x = 60;
+    const int gap_y = 70;
+    for( int y = 50; y <= 80; y++ ) {
+        if( y != gap_y ) {
+            here.ter_set( tripoint( wall_x, y, 0 ), wall );
+        }
+    }
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+
+    const tripoint target( 65, 60, 0 );
+    pathfinding_settings settings;
+    settings.max_dist = 20;
+    settings.max_length = 100;
+
+    const shared_route_stats before = here.get_shared_route_stats();
+    for( int y = 52; y <= 68; y += 4 ) {
+        const tripoint from( 56, y, 0 );
+        const std::vector<tripoint> shared = here.route_shared( from, target, settings );
+        const std::vector<tripoint> plain = here.route( from, target, settings );
+        CAPTURE( from );
+        check_route_is_walkable( here, shared, from, target );
+        CHECK( route_cost( from, shared ) == route_cost( from, plain ) );
+    }
+    const shared_route_stats after = here.get_shared_route_stats();
+    CHECK( after.fields == before.fields + 1 );
+    CHECK( after.misses == before.misses + 1 );
+    CHECK( after.hits == before.hits + 4 );
+
+    SECTION( "field is rebuilt when the map changes" ) {
+        here.ter_set( tripoint( wall_x, gap_y, 0 ), wall );
+        const tripoint from( 56, 60, 0 );
+        const std::vector<tripoint> shared = here.route_shared( from, target, settings );
+        check_route_is_walkable( here, shared, from, target );
+        CHECK( route_cost( from, shared ) == route_cost( from, here.route( from, target, settings ) ) );
+        CHECK( here.get_shared_route_stats().fields == after.fields + 1 );
+    }
+}
@@ -0,0 +1,225 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "type_id.h"
+
+// Far away from the test map, so that nothing else loads or saves it
+static const tripoint quad_omt( 100, 100, 0 );
+
+static std::string segment_dir()
+{
+    const tripoint segment = omt_to_seg_copy( quad_omt );
+    return string_format( "%s/maps/%d.%d.%d", g->get_world_base_save_path(), segment.x, segment.y,
+                          segment.z );
+}
+
+static std::string quad_file_path( const std::string &extension, const tripoint &omt = quad_omt )
+{
+    return string_format( "%s/%d.%d.%d.%s", segment_dir(), omt.x, omt.y, omt.z, extension );
+}
+
+static bool quad_file_exists( const tripoint &omt = quad_omt )
+{
+    return file_exist( quad_file_path( "map", omt ) ) || file_exist( quad_file_path( "bmap", omt ) );
+}
+
+// Adds a quad with a wall in a different place on each submap
+static void add_quad( mapbuffer &buffer, const tripoint &omt = quad_omt,
+                      time_point last_touched = calendar::turn_zero )
+{
+    const tripoint origin = omt_to_sm_copy( omt );
+    for( int i = 0; i < 4; i++ ) {
+        const tripoint pos = origin + point( i % 2, i / 2 );
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( pos ) );
+        sm->set_ter( point( i, i ), ter_id( "t_wall" ) );
+        sm->last_touched = last_touched;
+        REQUIRE( buffer.add_submap( pos, sm ) );
+    }
+}
+
+static void check_quad( mapbuffer &buffer, const tripoint &omt = quad_omt )
+{
+    const tripoint origin = omt_to_sm_copy( omt );
+    for( int i = 0; i < 4; i++ ) {
+        const submap *sm = buffer.lookup_submap( origin + point( i % 2, i / 2 ) );
+        REQUIRE( sm != nullptr );
+        CHECK( sm->get_ter( point( i, i ) ) == ter_id( "t_wall" ) );
+        CHECK( sm->get_ter( point( i + 1, i ) ) != ter_id( "t_wall" ) );
+    }
+}
+
+TEST_CASE( "mapbuffer_reads_quads_written_in_the_background", "[mapbuffer][savegame]" )
+{
+    // Quads aren't saved without mapgen
+    const bool old_disable_mapgen = disable_mapgen;
+    disable_mapgen = false;
+    on_out_of_scope restore( [&]() {
+        disable_mapgen = old_disable_mapgen;
+        remove_tree( segment_dir() );
+    } );
+    remove_tree( segment_dir() );
+
+    mapbuffer buffer;
+    add_quad( buffer );
+    const tripoint origin = omt_to_sm_copy( quad_omt );
+
+    SECTION( "quads that are not written yet are read from the write queue" ) {
+        buffer.set_io_paused( true );
+        buffer.save( true );
+        CHECK( buffer.size() == 0 );
+        CHECK_FALSE( quad_file_exists() );
+
+        const submap_io_stats before = buffer.get_io_stats();
+        check_quad( buffer );
+        // Neither prefetched nor read from disk
+        CHECK( buffer.get_io_stats().direct_reads == before.direct_reads );
+        CHECK_FALSE( quad_file_exists() );
+
+        buffer.set_io_paused( false );
+        buffer.flush();
+        CHECK( quad_file_exists() );
+    }
+
+    SECTION( "prefetched quads are read in the background" ) {
+        buffer.save( true );
+        buffer.flush();
+        REQUIRE( quad_file_exists() );
+        REQUIRE( buffer.size() == 0 );
+
+        const submap_io_stats before = buffer.get_io_stats();
+        buffer.prefetch( origin );
+        check_quad( buffer );
+        const submap_io_stats &after = buffer.get_io_stats();
+        CHECK( after.prefetch_hits + after.prefetch_stalls ==
+               before.prefetch_hits + before.prefetch_stalls + 1 );
+        CHECK( after.direct_reads == before.direct_reads );
+    }
+
+    SECTION( "failed writes are reported by flush" ) {
+        // A file where the directory of the quad should be
+        REQUIRE( assure_dir_exist( g->get_world_base_save_path() + "/maps" ) );
+        REQUIRE( write_to_file( segment_dir(), []( std::ostream & fout ) {
+            fout << "not a directory";
+        }, nullptr ) );
+        buffer.save( true );
+        CHECK_THROWS( buffer.flush() );
+        // Only reported once
+        CHECK_NOTHROW( buffer.flush() );
+        remove_file( segment_dir() );
+    }
+}
+
+TEST_CASE( "mapbuffer_unloads_the_least_recently_touched_quads", "[mapbuffer][savegame]" )
+{
+    const bool old_disable_mapgen = disable_mapgen;
+    disable_mapgen = false;
+    on_out_of_scope restore( [&]() {
+        disable_mapgen = old_disable_mapgen;
+        remove_tree( segment_dir() );
+    } );
+    remove_tree( segment_dir() );
+
+    // Touched in a different order than they're laid out in
+    const std::vector<int> touched_order = { 2, 0, 3, 1 };
+    std::vector<tripoint> quads;
+    mapbuffer buffer;
+    for( size_t i = 0; i < touched_order.size(); i++ ) {
+        quads.push_back( quad_omt + point( i, 0 ) );
+        add_quad( buffer, quads.back(), calendar::turn_zero + 1_hours * touched_order[i] );
+    }
+    const auto is_loaded = [&]( const tripoint & omt ) {
+        return buffer.is_submap_loaded( omt_to_sm_copy( omt ) );
+    };
+
+    buffer.unload_least_recently_touched( 4 * 2 );
+    CHECK( buffer.size() == 4 * 2 );
+    CHECK( buffer.get_io_stats().unloaded_submaps == 4 * 2 );
+    CHECK( is_loaded( quads[0] ) );
+    CHECK_FALSE( is_loaded( quads[1] ) );
+    CHECK( is_loaded( quads[2] ) );
+    CHECK_FALSE( is_loaded( quads[3] ) );
+
+    // Nothing is written until the game is saved
+    buffer.flush();
+    for( const tripoint &omt : quads ) {
+        CHECK_FALSE( quad_file_exists( omt ) );
+    }
+
+    SECTION( "unloaded quads are loaded the same" ) {
+        for( const tripoint &omt : quads ) {
+            check_quad( buffer, omt );
+        }
+        CHECK( buffer.size() == 4 * 4 );
+        CHECK( buffer.get_io_stats().direct_reads == 0 );
+    }
+
+    SECTION( "unloaded quads are written by the next save" ) {
+        buffer.save( true );
+        buffer.flush();
+        REQUIRE( buffer.size() == 0 );
+        for( const tripoint &omt : quads ) {
+            CHECK( quad_file_exists( omt ) );
+            check_quad( buffer, omt );
+        }
+    }
+
+    SECTION( "unloaded quads are dropped along with the rest" ) {
+        buffer.clear();
+        CHECK_FALSE( quad_file_exists( quads[1] ) );
+        CHECK( buffer.lookup_submap( omt_to_sm_copy( quads[1] ) ) == nullptr );
+    }
+}
+
+TEST_CASE( "mapbuffer_converts_json_quads_to_the_binary_format", "[mapbuffer][savegame]" )
+{
+    const std::string palette_path = g->get_world_base_save_path() + "/maps/ids.json";
+    const bool had_palette = file_exist( palette_path );
+    const bool old_disable_mapgen = disable_mapgen;
+    disable_mapgen = false;
+    on_out_of_scope restore( [&]() {
+        disable_mapgen = old_disable_mapgen;
+        remove_tree( segment_dir() );
+        if( !had_palette ) {
+            remove_file( palette_path );
+        }
+    } );
+    remove_tree( segment_dir() );
+
+    mapbuffer buffer;
+    add_quad( buffer );
+    {
+        override_option json_saves( "BINARY_MAP_SAVES", "false" );
+        buffer.save( true );
+        buffer.flush();
+    }
+    REQUIRE( file_exist( quad_file_path( "map" ) ) );
+    REQUIRE_FALSE( file_exist( quad_file_path( "bmap" ) ) );
+
+    override_option binary_saves( "BINARY_MAP_SAVES", "true" );
+    // Read from the JSON file, then saved again
+    check_quad( buffer );
+    buffer.save( true );
+    buffer.flush();
+    CHECK( file_exist( quad_file_path( "bmap" ) ) );
+    CHECK_FALSE( file_exist( quad_file_path( "map" ) ) );
+    CHECK( file_exist( palette_path ) );
+
+    // Read from the binary file, by a buffer that has to load the palette
+    mapbuffer reloaded;
+    check_quad( reloaded );
+}
@@ -8,8 +8,12 @@
 #include "map_helpers.h"
 #include "mapdata.h"
 #include "monster.h"
+#include "npc.h"
 #include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
 #include "state_helpers.h"
+#include "type_id.h"
 
 struct tripoint;
 
@@ -101,3 +105,43 @@ TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
     CHECK( !outside.sees( inside ) );
 
 }
+
+TEST_CASE( "monsters_share_field_of_view_of_npcs", "[vision]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    // The roof of the vehicle from the test above is still cached as a floor over the NPC
+    here.set_floor_cache_dirty( 1 );
+    build_test_map( ter_id( "t_floor" ) );
+    set_time( midday );
+    const tripoint npc_pos( 60, 60, 0 );
+    // Out of the way, but near enough for the NPC to be loaded
+    get_player_character().setpos( npc_pos + tripoint( 0, 0, -2 ) );
+    for( int y = 57; y <= 63; y++ ) {
+        here.ter_set( npc_pos + point( 5, y - 60 ), ter_id( "t_wall" ) );
+    }
+    npc &target = spawn_npc( npc_pos.xy(), "thug" );
+    here.build_map_cache( 0 );
+
+    monster &in_the_open = spawn_test_monster( "mon_zombie", npc_pos + point( -8, 3 ) );
+    monster &behind_wall = spawn_test_monster( "mon_zombie", npc_pos + point( 8, 0 ) );
+    monster &around_wall = spawn_test_monster( "mon_zombie", npc_pos + point( 8, -8 ) );
+    monster &far_away = spawn_test_monster( "mon_zombie", npc_pos + point( -55, 0 ) );
+
+    const shared_fov_cache &cache = here.get_shared_fov_cache();
+    const int casts = cache.casts;
+    CHECK( in_the_open.sees( target ) );
+    CHECK_FALSE( behind_wall.sees( target ) );
+    CHECK( around_wall.sees( target ) );
+    CHECK_FALSE( far_away.sees( target ) );
+    // Same as tracing lines
+    CHECK( here.sees( in_the_open.pos(), target.pos(), 60 ) );
+    CHECK_FALSE( here.sees( behind_wall.pos(), target.pos(), 60 ) );
+    CHECK( here.sees( around_wall.pos(), target.pos(), 60 ) );
+    CHECK( cache.casts == casts + 1 );
+
+    // Recast once the turn is over
+    calendar::turn += 1_turns;
+    CHECK( in_the_open.sees( target ) );
+    CHECK( cache.casts == casts + 2 );
+}
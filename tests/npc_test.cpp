@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "calendar.h"
+#include "cata_utility.h"
 #include "faction.h"
 #include "field.h"
 #include "field_type.h"
@@ -17,7 +18,9 @@
 #include "line.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
 #include "memory_fast.h"
+#include "monster.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "numeric_interval.h"
@@ -508,3 +511,134 @@ TEST_CASE( "random npc spawn chance" )
     CHECK( npc_overmap::spawn_chance_in_hour( 4 * days_in_year, 1.0 ) == Approx( 0.25 / 24.0 ) );
     CHECK( npc_overmap::spawn_chance_in_hour( 8 * days_in_year, 1.0 ) == Approx( 0.125 / 24.0 ) );
 }
+
+TEST_CASE( "npc_perception_snapshot_has_the_loaded_followers", "[npc]" )
+{
+    clear_all_state();
+    npc &follower = spawn_npc( point( 60, 60 ), "test_talker" );
+    spawn_npc( point( 62, 60 ), "test_talker" );
+    g->add_npc_follower( follower.getID() );
+    on_out_of_scope remove_follower( [&follower]() {
+        g->remove_npc_follower( follower.getID() );
+    } );
+
+    CHECK( npc_ai::perception_snapshot::current() == nullptr );
+    {
+        const npc_ai::perception_snapshot snapshot;
+        REQUIRE( npc_ai::perception_snapshot::current() == &snapshot );
+        CHECK( snapshot.followers == std::vector<npc *> { &follower } );
+        {
+            const npc_ai::perception_snapshot inner;
+            CHECK( npc_ai::perception_snapshot::current() == &inner );
+        }
+        CHECK( npc_ai::perception_snapshot::current() == &snapshot );
+    }
+    CHECK( npc_ai::perception_snapshot::current() == nullptr );
+}
+
+// Walls the player in, so that the NPCs are on their own
+static void wall_in_player()
+{
+    map &here = get_map();
+    const tripoint player_pos = get_player_character().pos();
+    for( const tripoint &p : here.points_in_radius( player_pos, 1 ) ) {
+        if( p != player_pos ) {
+            here.ter_set( p, ter_id( "t_wall" ) );
+        }
+    }
+    here.invalidate_map_cache( player_pos.z );
+    here.build_map_cache( player_pos.z );
+}
+
+// What an NPC wants to pick up, with a snapshot of what NPCs see or without one
+static std::pair<bool, tripoint> item_wanted( npc &guy, bool with_snapshot )
+{
+    // NPCs skip tiles whose number of items didn't change, liquids are never picked up
+    map &here = get_map();
+    for( const tripoint &p : here.points_in_radius( guy.pos(), 6 ) ) {
+        here.add_item( p, item::spawn( "water" ) );
+    }
+    guy.fetching_item = false;
+    guy.wanted_item_pos = tripoint_min;
+    std::optional<npc_ai::perception_snapshot> snapshot;
+    if( with_snapshot ) {
+        snapshot.emplace();
+    }
+    guy.find_item();
+    return { guy.fetching_item, guy.wanted_item_pos };
+}
+
+TEST_CASE( "npc_find_item_is_the_same_with_and_without_a_snapshot", "[npc]" )
+{
+    clear_all_state();
+    set_time( calendar::turn_zero + 12_hours );
+    g->place_player( tripoint( 10, 10, 0 ) );
+    wall_in_player();
+    map &here = get_map();
+    npc &guy = spawn_npc( point( 100, 100 ), "test_talker" );
+    // The player's things, which NPCs only take when none of the player's friends are watching
+    const auto add_players_item = [&]( const point & offset, const std::string & type ) {
+        detached_ptr<item> it = item::spawn( type );
+        it->set_owner( get_player_character() );
+        here.add_item( guy.pos() + offset, std::move( it ) );
+    };
+    add_players_item( point( 2, 1 ), "machete" );
+    add_players_item( point( -3, 0 ), "katana" );
+    add_players_item( point( 0, 4 ), "rock" );
+    here.build_map_cache( 0 );
+    REQUIRE_FALSE( get_player_character().sees( guy.pos() ) );
+
+    SECTION( "nobody is watching" ) {
+        const std::pair<bool, tripoint> without = item_wanted( guy, false );
+        CHECK( without.first );
+        CHECK( item_wanted( guy, true ) == without );
+    }
+
+    SECTION( "a follower of the player is watching" ) {
+        npc &follower = spawn_npc( guy.pos().xy() + point_east, "test_talker" );
+        g->add_npc_follower( follower.getID() );
+        on_out_of_scope remove_follower( [&follower]() {
+            g->remove_npc_follower( follower.getID() );
+        } );
+        here.build_map_cache( 0 );
+        REQUIRE( follower.sees( guy.pos() ) );
+
+        const std::pair<bool, tripoint> without = item_wanted( guy, false );
+        CHECK_FALSE( without.first );
+        CHECK( item_wanted( guy, true ) == without );
+    }
+}
+
+TEST_CASE( "npc_danger_is_the_same_with_and_without_a_snapshot", "[npc]" )
+{
+    clear_all_state();
+    set_time( calendar::turn_zero + 12_hours );
+    g->place_player( tripoint( 10, 10, 0 ) );
+    wall_in_player();
+    npc &guy = spawn_npc( point( 60, 60 ), "test_talker" );
+    monster &near = spawn_test_monster( "mon_zombie", guy.pos() + point( 3, 0 ) );
+    spawn_test_monster( "mon_zombie", guy.pos() + point( -5, 2 ) );
+    monster &dead = spawn_test_monster( "mon_zombie", guy.pos() + point( 0, 2 ) );
+    get_map().build_map_cache( 0 );
+
+    const auto assess = [&guy]( bool with_snapshot ) {
+        std::optional<npc_ai::perception_snapshot> snapshot;
+        if( with_snapshot ) {
+            snapshot.emplace();
+        }
+        guy.regen_ai_cache();
+        return std::make_pair( guy.danger_assessment(), guy.current_target() );
+    };
+    const std::pair<float, Creature *> without = assess( false );
+    // Without any monsters around it would be -10
+    CHECK( without.first > -10.0f );
+    CHECK( without.second != nullptr );
+    CHECK( assess( true ) == without );
+
+    // Monsters that died after the snapshot was made are left out
+    const npc_ai::perception_snapshot snapshot;
+    dead.die( nullptr );
+    guy.regen_ai_cache();
+    CHECK( guy.danger_assessment() < without.first );
+    CHECK( guy.current_target() == &near );
+}
@@ -68,3 +68,21 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_layers_are_sampled_from_the_layers", "[overmap]" )
+{
+    const point_abs_omt base( OMAPX * 3, OMAPY * -2 );
+    const om_noise::om_noise_layers layers( base, 1920237457 );
+    const om_noise::om_noise_layer_forest forest( base, 1920237457 );
+    const om_noise::om_noise_layer_floodplain floodplain( base, 1920237457 );
+    const om_noise::om_noise_layer_lake lake( base, 1920237457 );
+    // Including points outside of the overmap, which lakes are flood filled into
+    for( const point_om_omt &p : {
+             point_om_omt( 0, 0 ), point_om_omt( 17, 120 ), point_om_omt( OMAPX - 1, OMAPY - 1 ),
+             point_om_omt( -1, 5 ), point_om_omt( OMAPX, OMAPY + 7 )
+         } ) {
+        CHECK( layers.forest.noise_at( p ) == forest.noise_at( p ) );
+        CHECK( layers.floodplain.noise_at( p ) == floodplain.noise_at( p ) );
+        CHECK( layers.lake.noise_at( p ) == lake.noise_at( p ) );
+    }
+}
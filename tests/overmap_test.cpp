@@ -1,12 +1,18 @@
 #include "catch/catch.hpp"
 
 #include <algorithm>
+#include <array>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
+#include "character.h"
+#include "coordinates.h"
 #include "enums.h"
+#include "game.h"
 #include "game_constants.h"
+#include "mongroup.h"
 #include "numeric_interval.h"
 #include "omdata.h"
 #include "overmap.h"
@@ -213,3 +219,303 @@ TEST_CASE( "mutable_overmap_placement", "[overmap][slow]" )
         CHECK( successes > num_trials_per_overmap / 2 );
     }
 }
+
+static std::vector<oter_id> surface_of( const point_abs_om &p )
+{
+    overmap *om = overmap_buffer.get_existing( p );
+    REQUIRE( om != nullptr );
+    std::vector<oter_id> result;
+    for( int x = 0; x < OMAPX; ++x ) {
+        for( int y = 0; y < OMAPY; ++y ) {
+            result.push_back( om->ter( { x, y, 0 } ) );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "prefetched_noise_generates_the_same_overmap", "[overmap][slow]" )
+{
+    const point_abs_om origin( 4, -2 );
+    const auto generate = [&origin]() {
+        overmap_special_batch batch = overmap_specials::get_default_batch( origin );
+        rng_set_engine_seed( 1234 );
+        overmap_buffer.create_custom_overmap( origin, batch );
+        return surface_of( origin );
+    };
+
+    clear_all_state();
+    overmap_buffer.clear();
+    const std::vector<oter_id> expected = generate();
+
+    // Overmaps that exist already aren't prefetched
+    overmap_buffer.clear();
+    overmap_buffer.prefetch_around( origin + point_south );
+    // Layers that aren't being sampled yet aren't waited for, they're sampled right away
+    overmap_buffer.wait_for_prefetched_noise();
+
+    SECTION( "prefetched layers are there to take" ) {
+        CHECK( overmap_buffer.take_prefetched_noise( origin, g->get_seed() ) != nullptr );
+        CHECK( overmap_buffer.take_prefetched_noise( origin, g->get_seed() ) == nullptr );
+    }
+
+    SECTION( "prefetched layers are used up by generating the overmap" ) {
+        const std::vector<oter_id> actual = generate();
+        CHECK( overmap_buffer.take_prefetched_noise( origin, g->get_seed() ) == nullptr );
+        CHECK( expected == actual );
+    }
+}
+
+TEST_CASE( "long_travel_paths_go_through_the_gap", "[overmap][slow]" )
+{
+    clear_all_state();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    const oter_id field( "field" );
+    const oter_id earth( "empty_rock" );
+    for( int x = 0; x < OMAPX; x++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            om.ter_set( { x, y, 0 }, field );
+            om.set_path( { x, y, 0 }, false );
+            om.set_seen( { x, y, 0 }, true );
+        }
+    }
+
+    const overmap::travel_chunk &chunk = om.travel_chunk_at( { 5, 5, 0 } );
+    const auto count_of = [&chunk]( omt_travel_class c ) {
+        return chunk.count( 0, c );
+    };
+    CHECK( count_of( omt_travel_class::field ) == overmap::travel_chunk_size *
+           overmap::travel_chunk_size );
+    om.ter_set( { 5, 5, 0 }, earth );
+    CHECK( count_of( omt_travel_class::field ) == overmap::travel_chunk_size *
+           overmap::travel_chunk_size - 1 );
+    CHECK( count_of( omt_travel_class::solid ) == 1 );
+
+    // A wall across the overmap with a gap at its far end, and nothing outside the overmap
+    const int wall_x = OMAPX / 2;
+    const int gap_y = OMAPY - 5;
+    for( int y = 0; y < OMAPY; y++ ) {
+        om.ter_set( { wall_x, y, 0 }, y == gap_y ? field : earth );
+    }
+    overmap_path_params params;
+    params.field_cost = 15;
+    params.only_known_by_player = false;
+    params.avoid_danger = false;
+
+    const tripoint_abs_omt src( 10, 10, 0 );
+    const tripoint_abs_omt dest( OMAPX - 10, 10, 0 );
+    std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( std::count( path.begin(), path.end(), tripoint_abs_omt( wall_x, gap_y, 0 ) ) == 1 );
+    CHECK( std::count( path.begin(), path.end(), dest ) == 1 );
+
+    om.ter_set( { wall_x, gap_y, 0 }, earth );
+    CHECK( overmap_buffer.get_travel_path( src, dest, params ).empty() );
+}
+
+TEST_CASE( "long_travel_paths_respect_unseen_and_dangerous_terrain", "[overmap][slow]" )
+{
+    clear_all_state();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    const oter_id field( "field" );
+    const oter_id earth( "empty_rock" );
+    for( int x = 0; x < OMAPX; x++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            om.ter_set( { x, y, 0 }, field );
+            om.set_path( { x, y, 0 }, false );
+            om.set_seen( { x, y, 0 }, true );
+        }
+    }
+    // A wall across the overmap with a gap at each end
+    const int wall_x = OMAPX / 2;
+    const tripoint_om_omt near_gap( wall_x, 5, 0 );
+    const tripoint_om_omt far_gap( wall_x, OMAPY - 5, 0 );
+    for( int y = 0; y < OMAPY; y++ ) {
+        if( y != near_gap.y() && y != far_gap.y() ) {
+            om.ter_set( { wall_x, y, 0 }, earth );
+        }
+    }
+    overmap_path_params params;
+    params.field_cost = 15;
+    const tripoint_abs_omt src( 10, 10, 0 );
+    const tripoint_abs_omt dest( OMAPX - 10, 10, 0 );
+    const auto goes_through = [&]( const tripoint_om_omt & p ) {
+        const std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( src, dest, params );
+        REQUIRE_FALSE( path.empty() );
+        return std::count( path.begin(), path.end(), project_combine( point_abs_om(), p ) ) == 1;
+    };
+    const overmap::travel_chunk &chunk = om.travel_chunk_at( near_gap );
+    REQUIRE( goes_through( near_gap ) );
+
+    SECTION( "unseen terrain" ) {
+        om.set_seen( near_gap, false );
+        CHECK( chunk.count( overmap::travel_chunk::unseen, omt_travel_class::field ) == 1 );
+        CHECK( goes_through( far_gap ) );
+        params.only_known_by_player = false;
+        CHECK( goes_through( near_gap ) );
+    }
+
+    SECTION( "dangerous terrain" ) {
+        om.add_note( near_gap, "monsters" );
+        om.mark_note_dangerous( near_gap, 1, true );
+        CHECK( chunk.count( overmap::travel_chunk::dangerous, omt_travel_class::field ) == 3 * 3 - 2 );
+        CHECK( goes_through( far_gap ) );
+        params.avoid_danger = false;
+        CHECK( goes_through( near_gap ) );
+        params.avoid_danger = true;
+        om.delete_note( near_gap );
+        CHECK( chunk.count( overmap::travel_chunk::dangerous, omt_travel_class::field ) == 0 );
+        CHECK( goes_through( near_gap ) );
+    }
+}
+
+// Fields, forests and swamps with patches of earth in the way
+static void set_varied_terrain( overmap &om )
+{
+    const std::array<oter_id, 4> terrains = {{
+            oter_id( "field" ), oter_id( "field" ), oter_id( "forest" ), oter_id( "forest_water" )
+        }
+    };
+    const oter_id earth( "empty_rock" );
+    rng_set_engine_seed( 4321 );
+    for( int x = 0; x < OMAPX; x++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            om.ter_set( { x, y, 0 }, random_entry( terrains ) );
+            om.set_path( { x, y, 0 }, false );
+        }
+    }
+    for( int i = 0; i < 40; i++ ) {
+        const point corner( rng( 0, OMAPX - 15 ), rng( 0, OMAPY - 15 ) );
+        const point size( rng( 3, 15 ), rng( 3, 15 ) );
+        for( int x = corner.x; x < corner.x + size.x; x++ ) {
+            for( int y = corner.y; y < corner.y + size.y; y++ ) {
+                om.ter_set( { x, y, 0 }, earth );
+            }
+        }
+    }
+}
+
+static overmap_path_params varied_terrain_params()
+{
+    overmap_path_params params;
+    params.field_cost = 10;
+    params.forest_cost = 20;
+    params.swamp_cost = 40;
+    params.only_known_by_player = false;
+    params.avoid_danger = false;
+    return params;
+}
+
+static int travel_cost( const overmap &om, const std::vector<tripoint_abs_omt> &path )
+{
+    int cost = 0;
+    for( const tripoint_abs_omt &p : path ) {
+        switch( om.ter( project_remain<coords::om>( p ).remainder_tripoint )->get_travel_class() ) {
+            case omt_travel_class::field:
+                cost += 10;
+                break;
+            case omt_travel_class::forest:
+                cost += 20;
+                break;
+            case omt_travel_class::swamp:
+                cost += 40;
+                break;
+            default:
+                FAIL( "path goes through impassable terrain" );
+        }
+    }
+    return cost;
+}
+
+TEST_CASE( "long_travel_paths_cost_about_as_much_as_the_full_search", "[overmap][slow]" )
+{
+    clear_all_state();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    set_varied_terrain( om );
+    const overmap_path_params params = varied_terrain_params();
+
+    const std::array<std::pair<point_abs_omt, point_abs_omt>, 4> trips = {{
+            { point_abs_omt( 2, 2 ), point_abs_omt( OMAPX - 3, OMAPY - 3 ) },
+            { point_abs_omt( 2, OMAPY - 3 ), point_abs_omt( OMAPX - 3, 2 ) },
+            { point_abs_omt( 2, OMAPY / 2 ), point_abs_omt( OMAPX - 3, OMAPY / 2 ) },
+            { point_abs_omt( OMAPX / 2, 2 ), point_abs_omt( OMAPX / 2, OMAPY - 3 ) },
+        }
+    };
+    for( const auto &[from, to] : trips ) {
+        const tripoint_abs_omt src( from, 0 );
+        const tripoint_abs_omt dest( to, 0 );
+        om.ter_set( project_remain<coords::om>( src ).remainder_tripoint, oter_id( "field" ) );
+        om.ter_set( project_remain<coords::om>( dest ).remainder_tripoint, oter_id( "field" ) );
+        CAPTURE( src, dest );
+        const std::vector<tripoint_abs_omt> full = overmap_buffer.get_full_travel_path( src, dest,
+                params );
+        const std::vector<tripoint_abs_omt> chunked = overmap_buffer.get_travel_path( src, dest, params );
+        REQUIRE_FALSE( full.empty() );
+        REQUIRE_FALSE( chunked.empty() );
+        // The chunks only show how much of each terrain there is, so the path may take
+        // a worse way around, but no more than a fifth worse
+        const int full_cost = travel_cost( om, full );
+        const int chunked_cost = travel_cost( om, chunked );
+        CAPTURE( full_cost, chunked_cost );
+        CHECK( chunked_cost * 5 <= full_cost * 6 );
+    }
+}
+
+TEST_CASE( "long_travel_path_benchmark", "[.][overmap][benchmark]" )
+{
+    clear_all_state();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    set_varied_terrain( om );
+    const overmap_path_params params = varied_terrain_params();
+    const tripoint_abs_omt src( 2, 2, 0 );
+    const tripoint_abs_omt dest( OMAPX - 3, OMAPY - 3, 0 );
+    om.ter_set( project_remain<coords::om>( src ).remainder_tripoint, oter_id( "field" ) );
+    om.ter_set( project_remain<coords::om>( dest ).remainder_tripoint, oter_id( "field" ) );
+
+    BENCHMARK( "full search" ) {
+        return overmap_buffer.get_full_travel_path( src, dest, params );
+    };
+    BENCHMARK( "chunks first" ) {
+        return overmap_buffer.get_travel_path( src, dest, params );
+    };
+}
+
+TEST_CASE( "hordes_hear_signals_in_range_and_walk_onto_other_overmaps", "[overmap][slow]" )
+{
+    clear_all_state();
+    const tripoint_abs_sm player_sm( get_player_character().global_sm_location() );
+    const point_abs_om om_pos = project_to<coords::om>( player_sm.xy() );
+    overmap &om = overmap_buffer.get( om_pos );
+    overmap &east = overmap_buffer.get( om_pos + point_east );
+    om.clear_mon_groups();
+    east.clear_mon_groups();
+    const mongroup_id group_zombie( "GROUP_ZOMBIE" );
+
+    mongroup near( group_zombie, tripoint_om_sm( 10, 10, 0 ), 1, 10 );
+    near.horde = true;
+    near.target = tripoint_om_sm( 10, 40, 0 );
+    mongroup far = near;
+    far.pos = tripoint_om_sm( 100, 10, 0 );
+    far.target = far.pos;
+    om.add_mon_group( near );
+    om.add_mon_group( far );
+
+    // Without interest the signal is always followed
+    const point_abs_sm om_sm = project_to<coords::sm>( om_pos );
+    overmap_buffer.signal_hordes( tripoint_abs_sm( om_sm + point( 12, 10 ), 0 ), 5 );
+    mongroup heard = near;
+    heard.target = tripoint_om_sm( 12, 10, 0 );
+    heard.interest = 60;
+    CHECK( om.mongroup_check( heard ) );
+    CHECK( om.mongroup_check( far ) );
+
+    // Not a horde, so it isn't moved, but it is out of bounds
+    mongroup outside( group_zombie, tripoint_om_sm( OMAPX * 2 + 1, 7, 0 ), 1, 10 );
+    outside.target = outside.pos + point_east;
+    om.add_mon_group( outside );
+    overmap_buffer.move_hordes();
+    CHECK_FALSE( om.mongroup_check( outside ) );
+    mongroup handed_over = outside;
+    handed_over.pos = tripoint_om_sm( 1, 7, 0 );
+    handed_over.target = tripoint_om_sm( 2, 7, 0 );
+    CHECK( east.mongroup_check( handed_over ) );
+}
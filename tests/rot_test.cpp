@@ -1,9 +1,11 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "calendar.h"
 #include "enums.h"
+#include "game_constants.h"
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -204,3 +206,68 @@ TEST_CASE( "Items don't rot away on map load if in a freezer" )
     auto normal_stack_after = m.i_at( normal_pnt );
     REQUIRE( normal_stack_after.empty() );
 }
+
+// How item::process_rot used to catch up on rot, one hour at a time
+static detached_ptr<item> hourly_rot_reference( detached_ptr<item> &&it, bool seals,
+        const tripoint &pos, temperature_flag flag, const weather_manager &weather,
+        time_point last_rot_check, int hours )
+{
+    const units::temperature local_mod = units::from_fahrenheit( get_map().get_temperature(
+            pos ) ) - 0_f;
+    for( int hour = 1; hour <= hours; hour++ ) {
+        const time_point time = last_rot_check + hour * 1_hours;
+        units::temperature temperature = pos.z >= 0
+                                         ? weather.get_cur_weather_gen().get_weather_temperature(
+                                                 tripoint_abs_ms( get_map().getabs( pos ) ), time, calendar::config,
+                                                 g->get_seed() ) + local_mod
+                                         : temperatures::annual_average + local_mod;
+        if( flag == temperature_flag::TEMP_FREEZER ) {
+            temperature = std::min( temperature, temperatures::freezer );
+        }
+        // calc_rot only looks at the time since the last check
+        it->set_rot( it->get_rot() + it->calc_rot( last_rot_check + 1_hours, temperature ) );
+        if( it->has_rotten_away() && !seals ) {
+            return detached_ptr<item>();
+        }
+    }
+    return std::move( it );
+}
+
+TEST_CASE( "Rot catch-up matches hourly processing", "[rot]" )
+{
+    weather_manager weather;
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    const tripoint pos = GENERATE( tripoint_zero, tripoint( 0, 0, -1 ) );
+    const temperature_flag flag = GENERATE( temperature_flag::TEMP_NORMAL,
+                                            temperature_flag::TEMP_FREEZER );
+    const bool seals = GENERATE( false, true );
+    const int hours = GENERATE( 1, 30, 24 * 20, 24 * 200 );
+    CAPTURE( pos, static_cast<int>( flag ), seals, hours );
+
+    const time_point start = calendar::turn;
+    detached_ptr<item> expected = item::spawn( "meat_cooked", start );
+    detached_ptr<item> actual = item::spawn( "meat_cooked", start );
+    expected = hourly_rot_reference( std::move( expected ), seals, pos, flag, weather, start, hours );
+    if( expected ) {
+        // The last hour is processed at the current temperature
+        units::temperature temperature = weather.get_temperature( pos );
+        if( flag == temperature_flag::TEMP_FREEZER ) {
+            temperature = std::min( temperature, temperatures::freezer );
+        }
+        expected->set_rot( expected->get_rot() + expected->calc_rot( start + 1_hours, temperature ) );
+        if( expected->has_rotten_away() && !seals ) {
+            expected = detached_ptr<item>();
+        }
+    }
+
+    calendar::turn = start + ( hours + 1 ) * 1_hours;
+    actual = item::process_rot( std::move( actual ), seals, pos, nullptr, flag, weather );
+    calendar::turn = start;
+
+    REQUIRE( !!actual == !!expected );
+    if( expected ) {
+        CHECK( actual->get_rot() == expected->get_rot() );
+    }
+}
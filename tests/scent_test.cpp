@@ -1,6 +1,7 @@
 
 #include "scent_map.h"
 #include "catch/catch.hpp"
+#include "calendar.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "game.h"
@@ -8,6 +9,8 @@
 
 void old_scent_map_update( const tripoint &center, map &m,
                            std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent );
+void scalar_scent_map_update( const tripoint &center, map &m,
+                              std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent );
 
 static constexpr int SCENT_RADIUS = 40;
 void old_scent_map_update( const tripoint &center, map &m,
@@ -170,3 +173,192 @@ TEST_CASE( "scent_matches_old", "[.]" )
     }
 }
 
+
+// scent_map::update before it was vectorized and limited to the area with scent in it
+void scalar_scent_map_update( const tripoint &center, map &m,
+                              std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    //the block and reduce scent properties are folded into a single scent_transfer value here
+    //block=0 reduce=1 normal=5
+    std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X> scent_transfer;
+
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    // for loop constants
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            //handle vehicle holes
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            //Lingering scent
+            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
+                              scent_transfer[abs.x][abs.y] ) ;
+            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
+                           ( 45 - squares_used ) / 5;
+
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+static void scalar_scent_map_decay( std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    for( auto &elem : grscent ) {
+        for( auto &val : elem ) {
+            val = std::max( 0, val - 1 );
+        }
+    }
+}
+
+static void setup_scent_obstacles( map &here, const tripoint &origin )
+{
+    for( int i = -6; i <= 6; i++ ) {
+        here.ter_set( origin + point( i, -5 ), t_brick_wall );
+        here.ter_set( origin + point( 7, i ), t_rock_wall_half );
+    }
+    // Scent leaks through the gaps between diagonal vehicle walls
+    level_cache &cache = here.access_cache( origin.z );
+    cache.vehicle_obstructed_cache[origin.x - 3][origin.y + 3].nw = true;
+    cache.vehicle_obstructed_cache[origin.x + 2][origin.y + 4].ne = true;
+}
+
+TEST_CASE( "scent_update_matches_scalar", "[scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    setup_scent_obstacles( here, origin );
+    g->scent.reset();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> scalar_scent;
+    for( auto &elem : scalar_scent ) {
+        elem.fill( 0 );
+    }
+    const auto add_scent = [&]( const tripoint & p, int value ) {
+        g->scent.set( p, value, scenttype_id( "sc_human" ) );
+        scalar_scent[p.x][p.y] = value;
+    };
+    add_scent( origin, 1000 );
+    add_scent( origin + point( 10, 12 ), 500 );
+    add_scent( origin + point( -35, 3 ), 800 );
+
+    const auto check_same_scent = [&]() {
+        int differences = 0;
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                if( scalar_scent[x][y] != g->scent.get( { x, y, 0 } ) ) {
+                    differences++;
+                }
+            }
+        }
+        CHECK( differences == 0 );
+    };
+
+    for( int turn = 0; turn < 30; turn++ ) {
+        g->scent.update( origin, here );
+        scalar_scent_map_update( origin, here, scalar_scent );
+        if( turn % 3 == 0 ) {
+            g->scent.decay();
+            scalar_scent_map_decay( scalar_scent );
+        }
+        if( turn == 10 ) {
+            add_scent( origin + point( 20, -20 ), 300 );
+        }
+    }
+    check_same_scent();
+
+    // Once the scent is gone, nothing is left to update
+    for( int turn = 0; turn < 1000; turn++ ) {
+        g->scent.decay();
+        scalar_scent_map_decay( scalar_scent );
+    }
+    g->scent.update( origin, here );
+    scalar_scent_map_update( origin, here, scalar_scent );
+    check_same_scent();
+}
+
+TEST_CASE( "scent_update_benchmark", "[.][benchmark][scent]" )
+{
+    clear_all_state();
+    const tripoint origin( 60, 60, 0 );
+    g->place_player( origin );
+    map &here = get_map();
+    setup_scent_obstacles( here, origin );
+    g->scent.reset();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> scalar_scent;
+    for( auto &elem : scalar_scent ) {
+        elem.fill( 0 );
+    }
+    g->scent.set( origin, 1000, scenttype_id( "sc_human" ) );
+    scalar_scent[origin.x][origin.y] = 1000;
+    // Spread the scent out, so that most of the area around the player is updated
+    for( int turn = 0; turn < 40; turn++ ) {
+        g->scent.update( origin, here );
+        scalar_scent_map_update( origin, here, scalar_scent );
+    }
+
+    BENCHMARK( "scalar" ) {
+        scalar_scent_map_update( origin, here, scalar_scent );
+        return scalar_scent[origin.x][origin.y];
+    };
+    BENCHMARK( "vectorized" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+}
@@ -1,13 +1,18 @@
 #include "catch/catch.hpp"
 
 #include <array>
+#include <cmath>
 #include <chrono>
 #include <cstdio>
 #include <functional>
 #include <memory>
 #include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "cached_options.h"
+#include "cata_utility.h"
 #include "game_constants.h"
 #include "lightmap.h"
 #include "line.h" // For rl_dist.
@@ -670,3 +675,329 @@ TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
     clear_all_state();
     shadowcasting_runoff( 1, true );
 }
+
+// castLight as it was before distances were tabulated and rows were clipped to the map, with
+// the octant as arguments instead of template arguments.  The results must not have changed.
+namespace old_castlight
+{
+
+struct exp_lookup {
+    float values[90];
+    float transparency;
+
+    explicit exp_lookup( float trans ) : values(), transparency( trans ) {
+        for( int i = 0; i < 90; i++ ) {
+            values[i] = 1 / std::exp( trans * i );
+        }
+    }
+};
+
+static const exp_lookup openair_lookup( LIGHT_TRANSPARENCY_OPEN_AIR );
+
+static int fast_rl_dist( const tripoint &to )
+{
+    if( !trigdist ) {
+        return square_dist( tripoint_zero, to );
+    }
+    const int val = to.x * to.x + to.y * to.y + to.z * to.z;
+    if( val < 2 ) {
+        return val;
+    }
+    int a = 21;
+    for( int i = 0; i < 4; i++ ) {
+        const int b = val / a;
+        a = ( a + b ) / 2;
+    }
+    return a;
+}
+
+// NOLINTNEXTLINE(cata-xy)
+static quadrant quadrant_from_x_y( int x, int y )
+{
+    return ( x > 0 ) ?
+           ( ( y > 0 ) ? quadrant::NW : quadrant::SW ) :
+           ( ( y > 0 ) ? quadrant::NE : quadrant::SE );
+}
+
+struct octant {
+    int xx;
+    int xy;
+    int yx;
+    int yy;
+};
+
+using float_grid = float[MAPSIZE_X][MAPSIZE_Y];
+using blocked_grid = diagonal_blocks[MAPSIZE_X][MAPSIZE_Y];
+
+// NOLINTNEXTLINE(readability-function-size)
+static void cast_light( float_grid &output_cache, const float_grid &input_array,
+                        const blocked_grid &blocked_array, const octant &o, const point &offset,
+                        const exp_lookup *lookup, const float numerator, const int row, float start,
+                        const float end, float cumulative_transparency )
+{
+    const quadrant quad = quadrant_from_x_y( -o.xx - o.xy, -o.yx - o.yy );
+    const auto check_blocked = [ =, &blocked_array]( point p ) {
+        switch( quad ) {
+            case quadrant::NW:
+                return blocked_array[p.x][p.y].nw;
+            case quadrant::NE:
+                return blocked_array[p.x][p.y].ne;
+            case quadrant::SE:
+                return ( p.x < MAPSIZE_X - 1 && p.y < MAPSIZE_Y - 1 && blocked_array[p.x + 1][p.y + 1].nw );
+            case quadrant::SW:
+                return ( p.x > 1 && p.y < MAPSIZE_Y - 1 && blocked_array[p.x - 1][p.y + 1].ne );
+            default:
+                break;
+        }
+        return false;
+    };
+
+    const int radius = 60;
+    if( start < end ) {
+        return;
+    }
+    float last_intensity = 0.0;
+    tripoint delta;
+    for( int distance = row; distance <= radius; distance++ ) {
+        delta.y = -distance;
+        bool started_row = false;
+        float current_transparency = 0.0;
+        delta.x = std::ceil( std::max( static_cast<float>( -distance ),
+                                       ( ( -distance - 0.5f ) * start ) - 0.5f ) );
+        const int x_limit = std::floor( std::min( 0.0f, ( ( -distance + 0.5f ) * end ) - 0.5f ) ) + 1;
+
+        int last_dist = -1;
+        for( ; delta.x <= x_limit; delta.x++ ) {
+            const point current( offset.x + delta.x * o.xx + delta.y * o.xy,
+                                 offset.y + delta.x * o.yx + delta.y * o.yy );
+            if( !( current.x >= 0 && current.y >= 0 && current.x < MAPSIZE_X &&
+                   current.y < MAPSIZE_Y ) ) {
+                continue;
+            }
+            if( check_blocked( current ) ) {
+                continue;
+            }
+            if( !started_row ) {
+                started_row = true;
+                current_transparency = input_array[current.x][current.y];
+            }
+            if( lookup != nullptr ) {
+                const int dist = fast_rl_dist( delta );
+                last_intensity = sight_from_lookup( numerator, lookup->values[dist], dist );
+            } else {
+                const int dist = rl_dist( tripoint_zero, delta );
+                if( last_dist != dist ) {
+                    last_intensity = sight_calc( numerator, cumulative_transparency, dist );
+                    last_dist = dist;
+                }
+            }
+
+            const float new_transparency = input_array[current.x][current.y];
+            update_light( output_cache[current.x][current.y], last_intensity,
+                          sight_check( new_transparency, last_intensity ) ? quadrant::default_ : quad );
+
+            if( new_transparency == current_transparency ) {
+                continue;
+            }
+            const float trailingEdge = ( delta.x - 0.5f ) / ( delta.y + 0.5f );
+            if( sight_check( current_transparency, last_intensity ) ) {
+                if( lookup != nullptr && current_transparency != lookup->transparency ) {
+                    cast_light( output_cache, input_array, blocked_array, o, offset, nullptr, numerator,
+                                distance + 1, start, trailingEdge,
+                                accumulate_transparency( lookup->transparency, current_transparency, distance ) );
+                } else {
+                    float recursive_transparency = cumulative_transparency;
+                    if( lookup == nullptr ) {
+                        recursive_transparency = accumulate_transparency( cumulative_transparency,
+                                                 current_transparency, distance );
+                    }
+                    cast_light( output_cache, input_array, blocked_array, o, offset, lookup, numerator,
+                                distance + 1, start, trailingEdge, recursive_transparency );
+                }
+            }
+            if( !sight_check( current_transparency, last_intensity ) ) {
+                start = ( delta.x - 0.5f ) / ( delta.y - 0.5f );
+            } else {
+                start = trailingEdge;
+            }
+            if( start < end ) {
+                return;
+            }
+            current_transparency = new_transparency;
+        }
+        if( !sight_check( current_transparency, last_intensity ) ) {
+            break;
+        }
+        if( lookup != nullptr && current_transparency != lookup->transparency ) {
+            cast_light( output_cache, input_array, blocked_array, o, offset, nullptr, numerator,
+                        distance + 1, start, end,
+                        accumulate_transparency( lookup->transparency, current_transparency, distance ) );
+            return;
+        }
+        if( lookup == nullptr ) {
+            cumulative_transparency = accumulate_transparency( cumulative_transparency,
+                                      current_transparency, distance );
+        }
+    }
+}
+
+// castLightAllWithLookup with sight_calc, from the tile at offset, for open air fast paths only
+static void cast_light_all( float_grid &output_cache, const float_grid &input_array,
+                            const blocked_grid &blocked_array, const point &offset )
+{
+    static constexpr std::array<octant, 8> octants = {{
+            { 0, 1, 1, 0 }, { 1, 0, 0, 1 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+            { 0, 1, -1, 0 }, { 1, 0, 0, -1 }, { 0, -1, -1, 0 }, { -1, 0, 0, -1 }
+        }
+    };
+    for( const octant &o : octants ) {
+        const point first( offset.x - o.xx - o.xy, offset.y - o.yx - o.yy );
+        const bool fast_path = first.x >= 0 && first.y >= 0 && first.x < MAPSIZE_X &&
+                               first.y < MAPSIZE_Y &&
+                               input_array[first.x][first.y] == LIGHT_TRANSPARENCY_OPEN_AIR;
+        cast_light( output_cache, input_array, blocked_array, o, offset,
+                    fast_path ? &openair_lookup : nullptr, 1.0f, 1, 1.0f, 0.0f,
+                    LIGHT_TRANSPARENCY_OPEN_AIR );
+    }
+}
+
+} // namespace old_castlight
+
+static void fill_rooms( float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] )
+{
+    // Walls every 8 tiles with a doorway in each, roughly what a town block looks like
+    for( int x = 0; x < MAPSIZE * SEEX; ++x ) {
+        for( int y = 0; y < MAPSIZE * SEEY; ++y ) {
+            const bool wall = ( x % 8 == 0 && y % 8 != 4 ) || ( y % 8 == 0 && x % 8 != 4 );
+            transparency_cache[x][y] = wall ? LIGHT_TRANSPARENCY_SOLID : LIGHT_TRANSPARENCY_OPEN_AIR;
+        }
+    }
+}
+
+// Open air with patches of smoke, so that the fast paths are left and rejoined
+static void fill_smoke( float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] )
+{
+    std::uniform_int_distribution<int> distribution( 0, 9 );
+    for( auto &inner : transparency_cache ) {
+        for( float &square : inner ) {
+            const int roll = distribution( rng_get_engine() );
+            square = roll == 0 ? LIGHT_TRANSPARENCY_SOLID : roll < 3 ? LIGHT_TRANSPARENCY_OPEN_AIR * 5 :
+                     LIGHT_TRANSPARENCY_OPEN_AIR;
+        }
+    }
+}
+
+using layout_fill = void( * )( float ( & )[MAPSIZE * SEEX][MAPSIZE * SEEY] );
+
+static const std::vector<std::pair<std::string, layout_fill>> layouts = {
+    { "open air", []( float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] ) {
+            std::uninitialized_fill_n( &transparency_cache[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY,
+                                       LIGHT_TRANSPARENCY_OPEN_AIR );
+        }
+    },
+    { "random walls", []( float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] ) {
+            randomly_fill_transparency( transparency_cache );
+        }
+    },
+    { "rooms", fill_rooms },
+    { "smoke", fill_smoke },
+};
+
+static void shadowcasting_benchmark( const std::string &name,
+                                     const float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY] )
+{
+    static float seen_squares[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    std::uninitialized_fill_n( &blocked_cache[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY,
+                               diagonal_blocks{ false, false } );
+
+    // Center of the bubble, and a corner where most of the octants run off the map
+    for( const point &offset : { point( 65, 65 ), point( 10, 120 ) } ) {
+        BENCHMARK( string_format( "%s from %d,%d", name, offset.x, offset.y ) ) {
+            std::uninitialized_fill_n( &seen_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+            castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+            ( seen_squares, transparency_cache, blocked_cache, offset );
+            return seen_squares[offset.x][offset.y];
+        };
+        BENCHMARK( string_format( "%s from %d,%d, old code", name, offset.x, offset.y ) ) {
+            std::uninitialized_fill_n( &seen_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+            old_castlight::cast_light_all( seen_squares, transparency_cache, blocked_cache, offset );
+            return seen_squares[offset.x][offset.y];
+        };
+    }
+}
+
+TEST_CASE( "shadowcasting_layouts_benchmark", "[shadowcasting][benchmark][.]" )
+{
+    clear_all_state();
+    static float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    const bool old_trigdist = trigdist;
+
+    for( const bool trig : { false, true } ) {
+        trigdist = trig;
+        const std::string dist_name = trig ? "trigdist" : "squaredist";
+        for( const auto &layout : layouts ) {
+            layout.second( transparency_cache );
+            shadowcasting_benchmark( layout.first + ", " + dist_name, transparency_cache );
+        }
+    }
+    trigdist = old_trigdist;
+}
+
+TEST_CASE( "shadowcasting_matches_the_code_before_the_distance_table", "[shadowcasting]" )
+{
+    clear_all_state();
+    static float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static float seen_squares[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static float seen_squares_control[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    const bool old_trigdist = trigdist;
+    on_out_of_scope restore( [&]() {
+        trigdist = old_trigdist;
+    } );
+
+    // A few diagonal gaps blocked, like between two diagonal walls
+    std::uniform_int_distribution<int> distribution( 0, 19 );
+    for( auto &inner : blocked_cache ) {
+        for( diagonal_blocks &square : inner ) {
+            square = diagonal_blocks{ distribution( rng_get_engine() ) == 0,
+                                      distribution( rng_get_engine() ) == 0 };
+        }
+    }
+
+    // Inside, and on and next to each edge and corner of the map
+    const std::vector<point> offsets = {
+        point( 65, 65 ), point( 10, 120 ), point( 0, 0 ), point( MAPSIZE_X - 1, MAPSIZE_Y - 1 ),
+        point( 1, MAPSIZE_Y - 2 ), point( MAPSIZE_X - 2, 1 ), point( 0, 70 ), point( 70, MAPSIZE_Y - 1 )
+    };
+    for( const bool trig : { false, true } ) {
+        trigdist = trig;
+        for( const auto &layout : layouts ) {
+            layout.second( transparency_cache );
+            for( const point &offset : offsets ) {
+                CAPTURE( trig, layout.first, offset );
+                std::uninitialized_fill_n( &seen_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+                std::uninitialized_fill_n( &seen_squares_control[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, 0.0f );
+                castLightAllWithLookup<float, float, sight_calc, sight_check, update_light, accumulate_transparency, sight_from_lookup>
+                ( seen_squares, transparency_cache, blocked_cache, offset );
+                old_castlight::cast_light_all( seen_squares_control, transparency_cache, blocked_cache,
+                                               offset );
+
+                int mismatches = 0;
+                point first_mismatch;
+                for( int x = 0; x < MAPSIZE_X; ++x ) {
+                    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+                        if( seen_squares[x][y] != seen_squares_control[x][y] ) {
+                            if( mismatches == 0 ) {
+                                first_mismatch = point( x, y );
+                            }
+                            mismatches++;
+                        }
+                    }
+                }
+                CAPTURE( first_mismatch );
+                CHECK( mismatches == 0 );
+            }
+        }
+    }
+}
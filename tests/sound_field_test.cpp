@@ -0,0 +1,105 @@
+#include "catch/catch.hpp"
+
+#include <optional>
+#include <string>
+
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "monster.h"
+#include "point.h"
+#include "sound_field.h"
+#include "sounds.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static void build_room( map &here, const tripoint &center )
+{
+    for( const tripoint &p : here.points_in_radius( center, 1 ) ) {
+        if( p != center ) {
+            here.ter_set( p, ter_id( "t_wall" ) );
+        }
+    }
+}
+
+TEST_CASE( "sound_field_goes_around_walls", "[sound]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+    const tripoint source( 60, 60, 0 );
+    const tripoint room( 70, 60, 0 );
+    build_room( here, room );
+    here.build_map_cache( 0 );
+
+    sound_field field;
+    field.compute( here, source, 40 );
+
+    // Open ground doesn't muffle the sound
+    CHECK( field.muffling_at( source ) == 0 );
+    CHECK( field.muffling_at( source + point( -20, 15 ) ) == 0 );
+    CHECK( field.muffling_at( room + point( 3, 0 ) ) == 0 );
+    // Right behind the room, the last step can't be taken from inside its east wall
+    CHECK( field.muffling_at( room + point( 2, 0 ) ) == 1 );
+    // Only reaches as far as requested
+    CHECK( field.muffling_at( source + point( -39, 0 ) ) == 0 );
+    CHECK( field.muffling_at( source + point( -40, 0 ) ) == std::nullopt );
+    // Through the wall of the room
+    CHECK( field.muffling_at( room ) == sound_field::wall_attenuation );
+    CHECK( field.muffling_at( room + point_west ) == sound_field::wall_attenuation );
+    // Not covered by the field
+    CHECK( field.muffling_at( source + tripoint_above ) == 0 );
+}
+
+TEST_CASE( "walls_muffle_sounds_for_monsters", "[sound]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+    const tripoint source( 60, 60, 0 );
+    const tripoint in_room = source + point( 10, 0 );
+    const tripoint outside = source + point( -10, 0 );
+    build_room( here, in_room );
+    here.build_map_cache( 0 );
+
+    monster &listener_in_room = spawn_test_monster( "mon_zombie", in_room );
+    monster &listener_outside = spawn_test_monster( "mon_zombie", outside );
+    listener_in_room.wandf = 0;
+    listener_outside.wandf = 0;
+    // Sounds left over from other tests would be heard along with this one
+    sounds::reset_sounds();
+
+    sounds::sound( source, 15, sounds::sound_t::combat, "bang" );
+    sounds::process_sounds();
+
+    CHECK( listener_outside.wandf > 0 );
+    CHECK( listener_in_room.wandf == 0 );
+}
+
+TEST_CASE( "sound_propagation_benchmark", "[.][benchmark][sound]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+    for( int x = 10; x < MAPSIZE_X - 10; x += 12 ) {
+        for( int y = 10; y < MAPSIZE_Y - 10; y += 12 ) {
+            build_room( here, tripoint( x, y, 0 ) );
+        }
+    }
+    here.build_map_cache( 0 );
+    // A horde of listeners
+    for( int x = 2; x < MAPSIZE_X; x += 4 ) {
+        for( int y = 2; y < MAPSIZE_Y; y += 4 ) {
+            spawn_test_monster( "mon_zombie", tripoint( x, y, 0 ) );
+        }
+    }
+
+    BENCHMARK( "process_sounds" ) {
+        for( int i = 0; i < 20; i++ ) {
+            sounds::sound( tripoint( 5 + i * 6, 30 + ( i % 5 ) * 15, 0 ), 40, sounds::sound_t::combat,
+                           "bang" );
+        }
+        sounds::process_sounds();
+    };
+}
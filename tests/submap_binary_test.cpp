@@ -0,0 +1,179 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "coordinates.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "submap.h"
+#include "submap_binary.h"
+#include "type_id.h"
+
+static void check_same_submap( const submap &expected, const submap &actual )
+{
+    int differences = 0;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            if( expected.get_ter( p ) != actual.get_ter( p ) ||
+                expected.get_furn( p ) != actual.get_furn( p ) ||
+                expected.get_trap( p ) != actual.get_trap( p ) ||
+                expected.get_radiation( p ) != actual.get_radiation( p ) ||
+                expected.get_items( p ).size() != actual.get_items( p ).size() ) {
+                differences++;
+            }
+        }
+    }
+    CHECK( differences == 0 );
+}
+
+static std::string store_json( const tripoint &pos, const submap &sm )
+{
+    std::ostringstream fout;
+    JsonOut jsout( fout );
+    jsout.start_object();
+    jsout.member( "version", savegame_version );
+    jsout.member( "coordinates", pos );
+    sm.store( jsout );
+    jsout.end_object();
+    return fout.str();
+}
+
+TEST_CASE( "binary_submap_round_trip", "[submap][savegame]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    map &here = get_map();
+
+    here.ter_set( tripoint( 1, 2, 0 ), ter_id( "t_wall" ) );
+    here.furn_set( tripoint( 3, 4, 0 ), furn_id( "f_table" ) );
+    here.trap_set( tripoint( 5, 6, 0 ), trap_str_id( "tr_beartrap" ).id() );
+    here.set_radiation( tripoint( 7, 8, 0 ), 20 );
+    here.set_radiation( tripoint( 8, 8, 0 ), -3 );
+    here.add_item_or_charges( tripoint( 9, 10, 0 ), item::spawn( itype_id( "rock" ) ) );
+
+    const tripoint pos = here.get_abs_sub();
+    const submap *original = MAPBUFFER.lookup_submap( pos );
+    REQUIRE( original != nullptr );
+
+    submap_id_palette palette;
+    std::string data;
+    write_binary_quad_header( data, 1 );
+    write_binary_submap( data, pos, *original, palette );
+    CHECK( palette.is_modified() );
+    // Smaller than the same submap as JSON, though the items and such are JSON in both
+    CHECK( data.size() < store_json( pos, *original ).size() );
+
+    // The palette only stores string ids, so it survives changes to int ids
+    std::ostringstream palette_out;
+    JsonOut jsout( palette_out );
+    palette.serialize( jsout );
+    CHECK_FALSE( palette.is_modified() );
+    std::istringstream palette_in( palette_out.str() );
+    JsonIn jsin( palette_in );
+    submap_id_palette loaded_palette;
+    loaded_palette.deserialize( jsin );
+
+    binary_reader in( data );
+    REQUIRE( read_binary_quad_header( in ) == 1 );
+    tripoint loaded_pos;
+    const std::unique_ptr<submap> loaded = read_binary_submap( in, loaded_palette, loaded_pos );
+    CHECK( in.empty() );
+    CHECK( loaded_pos == pos );
+    check_same_submap( *original, *loaded );
+    CHECK( loaded->get_items( point( 9, 10 ) ).front()->typeId() == itype_id( "rock" ) );
+}
+
+TEST_CASE( "binary_submap_rejects_corrupt_data", "[submap][savegame]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_floor" ) );
+    const submap *original = MAPBUFFER.lookup_submap( get_map().get_abs_sub() );
+    REQUIRE( original != nullptr );
+
+    submap_id_palette palette;
+    std::string data;
+    write_binary_quad_header( data, 1 );
+    write_binary_submap( data, tripoint_zero, *original, palette );
+
+    binary_reader in( std::string_view( data ).substr( 0, data.size() / 2 ) );
+    tripoint loaded_pos;
+    REQUIRE( read_binary_quad_header( in ) == 1 );
+    CHECK_THROWS( read_binary_submap( in, palette, loaded_pos ) );
+}
+
+// Generates the overmap terrain far away from the test map, returns its first submap
+static const submap &generate_far_away( const std::string &terrain, tripoint &pos )
+{
+    const tripoint_abs_omt omt( 100, 100, 0 );
+    overmap_buffer.ter_set( omt, oter_id( terrain ) );
+    pos = omt_to_sm_copy( omt.raw() );
+    if( !MAPBUFFER.is_submap_loaded( pos ) ) {
+        tinymap tm;
+        tm.generate( pos, calendar::turn );
+    }
+    const submap *sm = MAPBUFFER.lookup_submap( pos );
+    REQUIRE( sm != nullptr );
+    return *sm;
+}
+
+TEST_CASE( "binary_submap_benchmark", "[.][benchmark][submap]" )
+{
+    clear_all_state();
+    // Not a uniform test map, but a house with its furniture and items
+    const bool old_disable_mapgen = disable_mapgen;
+    disable_mapgen = false;
+    on_out_of_scope restore( [&]() {
+        disable_mapgen = old_disable_mapgen;
+    } );
+    tripoint pos;
+    const submap &original = generate_far_away( "house_01_north", pos );
+    REQUIRE_FALSE( original.is_uniform );
+
+    submap_id_palette palette;
+    std::string data;
+    write_binary_submap( data, pos, original, palette );
+    const std::string json = store_json( pos, original );
+    WARN( "binary: " << data.size() << " bytes, JSON: " << json.size() << " bytes" );
+
+    BENCHMARK( "save JSON" ) {
+        return store_json( pos, original );
+    };
+    BENCHMARK( "save binary" ) {
+        std::string out;
+        write_binary_submap( out, pos, original, palette );
+        return out;
+    };
+    BENCHMARK( "load JSON" ) {
+        std::istringstream fin( json );
+        JsonIn jsin( fin );
+        submap sm( tripoint_zero );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string name = jsin.get_member_name();
+            if( name == "version" || name == "coordinates" ) {
+                jsin.skip_value();
+            } else {
+                sm.load( jsin, name, savegame_version, multiply_xy( pos, 12 ) );
+            }
+        }
+        return sm.get_ter( point_zero );
+    };
+    BENCHMARK( "load binary" ) {
+        binary_reader in( data );
+        tripoint loaded_pos;
+        return read_binary_submap( in, palette, loaded_pos );
+    };
+}
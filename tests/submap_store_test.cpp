@@ -0,0 +1,66 @@
+#include "catch/catch.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+
+#include "point.h"
+#include "submap.h"
+#include "submap_store.h"
+
+static void check_same_contents( const submap_store &store, const std::map<tripoint, submap *> &expected )
+{
+    REQUIRE( store.size() == expected.size() );
+    int mismatches = 0;
+    for( const auto &elem : expected ) {
+        if( store.find( elem.first ) != elem.second ) {
+            mismatches++;
+        }
+    }
+    for( const auto &elem : store ) {
+        const auto it = expected.find( elem.first );
+        if( it == expected.end() || it->second != elem.second.get() ) {
+            mismatches++;
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "submap_store_matches_ordered_map", "[submap]" )
+{
+    submap_store store;
+    std::map<tripoint, submap *> expected;
+    std::mt19937 rng( 1234 );
+    std::uniform_int_distribution<int> coord( -40, 40 );
+    std::uniform_int_distribution<int> zlevel( -2, 2 );
+
+    for( int i = 0; i < 5000; i++ ) {
+        const tripoint p( coord( rng ), coord( rng ), zlevel( rng ) );
+        if( rng() % 3 == 0 ) {
+            const std::unique_ptr<submap> removed = store.erase( p );
+            const auto it = expected.find( p );
+            if( it == expected.end() ) {
+                CHECK( removed == nullptr );
+            } else {
+                CHECK( removed.get() == it->second );
+                expected.erase( it );
+            }
+        } else {
+            std::unique_ptr<submap> sm = std::make_unique<submap>( tripoint_zero );
+            submap *const added = sm.get();
+            const bool inserted = store.insert( p, sm );
+            CHECK( inserted == !expected.contains( p ) );
+            if( inserted ) {
+                CHECK( sm == nullptr );
+                expected.emplace( p, added );
+            } else {
+                CHECK( sm != nullptr );
+            }
+        }
+    }
+    check_same_contents( store, expected );
+
+    store.clear();
+    CHECK( store.empty() );
+    CHECK( store.find( tripoint_zero ) == nullptr );
+}
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "avatar.h"
+#include "bench_helpers.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "color.h"
@@ -204,10 +205,11 @@ static name_value_pair_t split_pair( const std::string &s, const char sep )
     }
 }
 
-static option_overrides_t extract_option_overrides( std::vector<const char *> &arg_vec )
+static option_overrides_t extract_name_value_pairs( std::vector<const char *> &arg_vec,
+        const std::string &tag )
 {
     option_overrides_t ret;
-    std::string option_overrides_string = extract_argument( arg_vec, "--option_overrides=" );
+    std::string option_overrides_string = extract_argument( arg_vec, tag );
     if( option_overrides_string.empty() ) {
         return ret;
     }
@@ -216,7 +218,7 @@ static option_overrides_t extract_option_overrides( std::vector<const char *> &a
     size_t i = 0;
     size_t pos = option_overrides_string.find( delim );
     while( pos != std::string::npos ) {
-        std::string part = option_overrides_string.substr( i, pos );
+        std::string part = option_overrides_string.substr( i, pos - i );
         ret.emplace_back( split_pair( part, sep ) );
         i = ++pos;
         pos = option_overrides_string.find( delim, pos );
@@ -278,7 +280,11 @@ int main( int argc, const char *argv[] )
         mods.insert( mods.begin(), def_core_mod_id ); // @todo move unit test items to core
     }
 
-    option_overrides_t option_overrides_for_test_suite = extract_option_overrides( arg_vec );
+    option_overrides_t option_overrides_for_test_suite = extract_name_value_pairs( arg_vec,
+            "--option_overrides=" );
+    for( const name_value_pair_t &config : extract_name_value_pairs( arg_vec, "--bench_config=" ) ) {
+        bench_config[config.first] = config.second;
+    }
 
     const bool dont_save = check_remove_flags( arg_vec, { "-D", "--drop-world" } );
 
@@ -305,6 +311,8 @@ int main( int argc, const char *argv[] )
         cata_printf( "  -D, --drop-world             Don't save the world on test failure.\n" );
         cata_printf( "  --option_overrides=n:v[,…]   Name-value pairs of game options for tests.\n" );
         cata_printf( "                               (overrides config/options.json values)\n" );
+        cata_printf( "  --bench_config=n:v[,…]       Name-value pairs of settings for benchmarks.\n" );
+        cata_printf( "                               (see tests/turn_benchmark_test.cpp)\n" );
         cata_printf( "  --error-format=<value>       Format of error messages.  Possible values are:\n" );
         cata_printf( "                                   human-readable (default)\n" );
         cata_printf( "                                   github-action\n" );
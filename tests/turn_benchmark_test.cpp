@@ -0,0 +1,168 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "bench_helpers.h"
+#include "cata_utility.h"
+#include "field_type.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "turn_profiler.h"
+#include "type_id.h"
+#include "units.h"
+
+/**
+ * Runs turns of a fixed scene through game::do_turn and reports how fast they were as JSON.
+ *
+ * Run it with the cata_bench target, or with `cata_test --rng-seed 1 "[turn_benchmark]"`.
+ * The scene can be changed with --bench_config=n:v[,…], see the settings below.
+ * The same seed and settings simulate the same turns, so runs on different commits
+ * can be compared.  The per-phase times come from the turn profiler's zones.
+ */
+
+struct bench_settings {
+    int turns = get_bench_config( "turns", 500 );
+    // Not measured, lets the scene settle after being set up
+    int warmup = get_bench_config( "warmup", 20 );
+    int zombies = get_bench_config( "zombies", 60 );
+    int fires = get_bench_config( "fires", 16 );
+    int vehicles = get_bench_config( "vehicles", 4 );
+    int npcs = get_bench_config( "npcs", 4 );
+    // Written to standard output when empty
+    std::string report = get_bench_config( "report", std::string() );
+};
+
+static std::vector<tripoint> grid( const point &origin, int count, int columns, int spacing )
+{
+    std::vector<tripoint> result;
+    for( int i = 0; i < count; i++ ) {
+        result.emplace_back( origin + point( i % columns, i / columns ) * spacing, 0 );
+    }
+    return result;
+}
+
+static void set_up_scene( const bench_settings &settings )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_grass" ) );
+    // The player never acts, so they stay out of the way
+    put_player_underground();
+    map &here = get_map();
+
+    for( const tripoint &p : grid( point( 10, 10 ), settings.zombies, 12, 3 ) ) {
+        spawn_test_monster( "mon_zombie", p );
+    }
+    for( const tripoint &p : grid( point( 60, 60 ), settings.npcs, 4, 4 ) ) {
+        spawn_npc( p.xy(), "test_talker" );
+    }
+    for( const tripoint &p : grid( point( 20, 90 ), settings.vehicles, 4, 12 ) ) {
+        REQUIRE( here.add_vehicle( vproto_id( "car" ), p, 0_degrees, 0, 0 ) != nullptr );
+    }
+    for( const tripoint &p : grid( point( 100, 20 ), settings.fires, 4, 3 ) ) {
+        here.add_field( p, fd_fire, 3 );
+    }
+}
+
+static void add_zones( std::vector<turn_profiler::zone_total> &totals,
+                       const std::vector<turn_profiler::zone_total> &zones )
+{
+    for( const turn_profiler::zone_total &zone : zones ) {
+        const auto it = std::find_if( totals.begin(), totals.end(),
+        [&zone]( const turn_profiler::zone_total & total ) {
+            return std::strcmp( total.name, zone.name ) == 0;
+        } );
+        if( it == totals.end() ) {
+            totals.push_back( zone );
+        } else {
+            it->ns += zone.ns;
+            it->calls += zone.calls;
+        }
+    }
+}
+
+static void write_report( std::ostream &out, const bench_settings &settings, double seconds,
+                          std::vector<turn_profiler::zone_total> phases )
+{
+    std::sort( phases.begin(), phases.end(), []( const turn_profiler::zone_total & l,
+    const turn_profiler::zone_total & r ) {
+        return l.ns > r.ns;
+    } );
+    JsonOut jsout( out, true );
+    jsout.start_object();
+    jsout.member( "seed", Catch::rngSeed() );
+    jsout.member( "turns", settings.turns );
+    jsout.member( "zombies", settings.zombies );
+    jsout.member( "fires", settings.fires );
+    jsout.member( "vehicles", settings.vehicles );
+    jsout.member( "npcs", settings.npcs );
+    jsout.member( "seconds", seconds );
+    jsout.member( "turns_per_second", settings.turns / seconds );
+    jsout.member( "phases" );
+    jsout.start_array();
+    for( const turn_profiler::zone_total &phase : phases ) {
+        jsout.start_object();
+        jsout.member( "name", std::string( phase.name ) );
+        jsout.member( "ms_per_turn", phase.ns / 1e6 / settings.turns );
+        jsout.member( "calls_per_turn", static_cast<double>( phase.calls ) / settings.turns );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+    out << '\n';
+}
+
+TEST_CASE( "turn_benchmark", "[.][benchmark][turn_benchmark]" )
+{
+    const bench_settings settings;
+    REQUIRE( settings.turns > 0 );
+    override_option no_autosave( "AUTOSAVE", "false" );
+    override_option no_redraw( "FORCE_REDRAW", "false" );
+    override_option no_random_npcs( "RANDOM_NPC", "false" );
+    on_out_of_scope disable_profiler( []() {
+        turn_profiler::set_enabled( false );
+        turn_profiler::clear();
+    } );
+    set_up_scene( settings );
+
+    avatar &u = get_avatar();
+    const auto run_turn = [&u]() {
+        // Without moves left the player isn't asked for input
+        u.moves = -1000;
+        REQUIRE_FALSE( g->do_turn() );
+    };
+    for( int i = 0; i < settings.warmup; i++ ) {
+        run_turn();
+    }
+
+    turn_profiler::clear();
+    turn_profiler::set_enabled( true );
+    std::vector<turn_profiler::zone_total> phases;
+    const auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < settings.turns; i++ ) {
+        run_turn();
+        add_zones( phases, turn_profiler::recent_turns().back().zones );
+    }
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    if( settings.report.empty() ) {
+        write_report( std::cout, settings, seconds.count(), phases );
+    } else {
+        write_to_file( settings.report, [&]( std::ostream & out ) {
+            write_report( out, settings, seconds.count(), phases );
+        } );
+    }
+}
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#include "mingw.thread.h"
+#endif
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "json.h"
+#include "turn_profiler.h"
+
+static const turn_profiler::zone_total *find_zone( const turn_profiler::turn_summary &turn,
+        const char *name )
+{
+    const auto it = std::find_if( turn.zones.begin(), turn.zones.end(),
+    [name]( const turn_profiler::zone_total & zone ) {
+        return std::strcmp( zone.name, name ) == 0;
+    } );
+    return it == turn.zones.end() ? nullptr : &*it;
+}
+
+TEST_CASE( "turn_profiler_adds_up_zones_per_turn", "[profiler]" )
+{
+    on_out_of_scope disable( []() {
+        turn_profiler::set_enabled( false );
+        turn_profiler::clear();
+    } );
+    turn_profiler::clear();
+
+    {
+        CATA_TURN_ZONE( "while_off" );
+    }
+    turn_profiler::set_enabled( true );
+    for( int i = 0; i < 3; i++ ) {
+        CATA_TURN_ZONE( "outer" );
+        {
+            CATA_TURN_ZONE( "inner" );
+        }
+    }
+    std::thread worker( []() {
+        CATA_TURN_ZONE( "worker" );
+    } );
+    worker.join();
+    turn_profiler::end_turn( calendar::turn_zero );
+
+    REQUIRE( turn_profiler::recent_turns().size() == 1 );
+    const turn_profiler::turn_summary &turn = turn_profiler::recent_turns().back();
+    CHECK( turn.dropped == 0 );
+    CHECK( find_zone( turn, "while_off" ) == nullptr );
+    REQUIRE( find_zone( turn, "outer" ) != nullptr );
+    REQUIRE( find_zone( turn, "inner" ) != nullptr );
+    CHECK( find_zone( turn, "outer" )->calls == 3 );
+    CHECK( find_zone( turn, "outer" )->ns >= find_zone( turn, "inner" )->ns );
+    CHECK( find_zone( turn, "worker" ) != nullptr );
+
+    // Zones are only counted in the turn they ended in
+    turn_profiler::end_turn( calendar::turn_zero + 1_turns );
+    REQUIRE( turn_profiler::recent_turns().size() == 2 );
+    CHECK( turn_profiler::recent_turns().back().zones.empty() );
+    CHECK( turn_profiler::recent_turns().back().frame_ns > 0 );
+    CHECK( turn_profiler::average_turn().size() == 3 );
+
+    std::ostringstream trace;
+    turn_profiler::write_chrome_trace( trace );
+    std::istringstream trace_in( trace.str() );
+    JsonIn jsin( trace_in );
+    JsonObject jo = jsin.get_object();
+    jo.allow_omitted_members();
+    std::vector<std::string> names;
+    for( JsonObject event : jo.get_array( "traceEvents" ) ) {
+        event.allow_omitted_members();
+        CHECK( event.get_string( "ph" ) == "X" );
+        CHECK( event.get_float( "dur" ) >= 0 );
+        names.push_back( event.get_string( "name" ) );
+    }
+    // Three outer and inner zones, one from the worker and one per turn after the first
+    CHECK( names.size() == 8 );
+    CHECK( std::count( names.begin(), names.end(), "turn" ) == 1 );
+}